@@ -4,6 +4,7 @@
 
 #include <boost/pool/object_pool.hpp>
 
+#include <Memory/TypedFixedUnorderedPool.hpp>
 #include <Memory/UnorderedPool.hpp>
 #include <Memory/TypedUnorderedPool.hpp>
 
@@ -116,6 +117,20 @@ private:
     Memory::TypedUnorderedPool <ObjectType> pool_ {MEMORY_LIBRARY_PAGE_CAPACITY};
 };
 
+template <typename ObjectType>
+class TypedFixedUnorderedPoolAdapter
+{
+public:
+    using EntryType = ObjectType;
+
+    ObjectType *Acquire ();
+
+    void Free (ObjectType *object);
+
+private:
+    Memory::TypedFixedUnorderedPool <ObjectType, MEMORY_LIBRARY_PAGE_CAPACITY> pool_;
+};
+
 template <typename ObjectType>
 class UnorderedTrivialPoolAdapter
 {
@@ -253,6 +268,18 @@ void TypedUnorderedPoolAdapter <ObjectType>::Free (ObjectType *object)
     pool_.Free (object);
 }
 
+template <typename ObjectType>
+ObjectType *TypedFixedUnorderedPoolAdapter <ObjectType>::Acquire ()
+{
+    return pool_.Acquire ();
+}
+
+template <typename ObjectType>
+void TypedFixedUnorderedPoolAdapter <ObjectType>::Free (ObjectType *object)
+{
+    pool_.Free (object);
+}
+
 template <typename ObjectType>
 ObjectType *UnorderedTrivialPoolAdapter <ObjectType>::Acquire ()
 {
@@ -105,6 +105,12 @@ BENCHMARK_TEMPLATE(AllocateDeallocate, TypedUnorderedPoolAdapter <Component192b>
 
 BENCHMARK_TEMPLATE(AllocateDeallocate, TypedUnorderedPoolAdapter <Component1032b>);
 
+BENCHMARK_TEMPLATE(AllocateDeallocate, TypedFixedUnorderedPoolAdapter <Component32b>);
+
+BENCHMARK_TEMPLATE(AllocateDeallocate, TypedFixedUnorderedPoolAdapter <Component192b>);
+
+BENCHMARK_TEMPLATE(AllocateDeallocate, TypedFixedUnorderedPoolAdapter <Component1032b>);
+
 BENCHMARK_TEMPLATE(AllocateDeallocate, TypedUnorderedTrivialPoolAdapter <TrivialComponent32b>);
 
 BENCHMARK_TEMPLATE(AllocateDeallocate, TypedUnorderedTrivialPoolAdapter <TrivialComponent192b>);
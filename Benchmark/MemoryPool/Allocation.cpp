@@ -80,6 +80,12 @@ BENCHMARK_TEMPLATE(Allocation, TypedUnorderedPoolAdapter <Component192b>);
 
 BENCHMARK_TEMPLATE(Allocation, TypedUnorderedPoolAdapter <Component1032b>);
 
+BENCHMARK_TEMPLATE(Allocation, TypedFixedUnorderedPoolAdapter <Component32b>);
+
+BENCHMARK_TEMPLATE(Allocation, TypedFixedUnorderedPoolAdapter <Component192b>);
+
+BENCHMARK_TEMPLATE(Allocation, TypedFixedUnorderedPoolAdapter <Component1032b>);
+
 BENCHMARK_TEMPLATE(Allocation, TypedUnorderedTrivialPoolAdapter <TrivialComponent32b>);
 
 BENCHMARK_TEMPLATE(Allocation, TypedUnorderedTrivialPoolAdapter <TrivialComponent192b>);
@@ -0,0 +1,67 @@
+#include <array>
+
+#include <benchmark/benchmark.h>
+
+#include "Adapters.hpp"
+#include "DataTypes.hpp"
+
+#define CLEAN_TEST_ITEM_COUNT 10000u
+
+// Not default destructor, therefore pools can not detect that destruction is trivial.
+template <typename Entry>
+void ExplicitEntryDestructor (Entry *entry) noexcept
+{
+    Memory::EntryDefaultDestructor (entry);
+}
+
+// Used to compare trivial destruction fast path with generic clean, that searches for used chunks.
+template <typename Entry>
+using ExplicitDestructorPool =
+    Memory::TypedUnorderedPool <Entry, Memory::EntryDefaultConstructor, ExplicitEntryDestructor>;
+
+template <typename Pool>
+void Clean (benchmark::State &state)
+{
+    std::array <typename Pool::ValueType *, CLEAN_TEST_ITEM_COUNT> allocated {};
+    for (auto _ : state)
+    {
+        state.PauseTiming ();
+        auto *pool = new Pool (MEMORY_LIBRARY_PAGE_CAPACITY);
+
+        for (std::size_t item = 0u; item < CLEAN_TEST_ITEM_COUNT; ++item)
+        {
+            allocated[item] = pool->Acquire ();
+        }
+
+        // Free half of objects, so pool has both used and free chunks on every page.
+        for (std::size_t item = 0u; item < CLEAN_TEST_ITEM_COUNT; item += 2u)
+        {
+            pool->Free (allocated[item]);
+        }
+
+        state.ResumeTiming ();
+        pool->Clean ();
+
+        state.PauseTiming ();
+        delete pool;
+        state.ResumeTiming ();
+    }
+}
+
+BENCHMARK_TEMPLATE(Clean, Memory::TypedUnorderedPool <Component32b>);
+
+BENCHMARK_TEMPLATE(Clean, Memory::TypedUnorderedPool <Component192b>);
+
+BENCHMARK_TEMPLATE(Clean, Memory::TypedUnorderedPool <Component1032b>);
+
+BENCHMARK_TEMPLATE(Clean, ExplicitDestructorPool <Component32b>);
+
+BENCHMARK_TEMPLATE(Clean, ExplicitDestructorPool <Component192b>);
+
+BENCHMARK_TEMPLATE(Clean, ExplicitDestructorPool <Component1032b>);
+
+BENCHMARK_TEMPLATE(Clean, Memory::TypedUnorderedTrivialPool <TrivialComponent32b>);
+
+BENCHMARK_TEMPLATE(Clean, Memory::TypedUnorderedTrivialPool <TrivialComponent192b>);
+
+BENCHMARK_TEMPLATE(Clean, Memory::TypedUnorderedTrivialPool <TrivialComponent1032b>);
@@ -96,6 +96,12 @@ BENCHMARK_TEMPLATE(Deallocation, TypedUnorderedPoolAdapter <Component192b>);
 
 BENCHMARK_TEMPLATE(Deallocation, TypedUnorderedPoolAdapter <Component1032b>);
 
+BENCHMARK_TEMPLATE(Deallocation, TypedFixedUnorderedPoolAdapter <Component32b>);
+
+BENCHMARK_TEMPLATE(Deallocation, TypedFixedUnorderedPoolAdapter <Component192b>);
+
+BENCHMARK_TEMPLATE(Deallocation, TypedFixedUnorderedPoolAdapter <Component1032b>);
+
 BENCHMARK_TEMPLATE(Deallocation, TypedUnorderedTrivialPoolAdapter <TrivialComponent32b>);
 
 BENCHMARK_TEMPLATE(Deallocation, TypedUnorderedTrivialPoolAdapter <TrivialComponent192b>);
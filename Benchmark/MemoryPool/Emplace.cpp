@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include "Adapters.hpp"
+#include "DataTypes.hpp"
+
+#define EMPLACE_TEST_ITEM_COUNT 10000u
+
+// Fills component with values, that differ from defaults, so default construction can not be reused.
+template <typename Component>
+Component MakePrototype ()
+{
+    Component prototype {};
+    auto *bytes = reinterpret_cast <uint8_t *> (&prototype);
+
+    for (std::size_t index = 0u; index < sizeof (Component); ++index)
+    {
+        bytes[index] = static_cast <uint8_t> (index);
+    }
+
+    return prototype;
+}
+
+template <typename Component>
+void AcquireAndAssign (benchmark::State &state)
+{
+    const Component prototype = MakePrototype <Component> ();
+    for (auto _ : state)
+    {
+        state.PauseTiming ();
+        auto *pool = new Memory::TypedUnorderedPool <Component> (MEMORY_LIBRARY_PAGE_CAPACITY);
+        state.ResumeTiming ();
+
+        for (std::size_t item = 0u; item < EMPLACE_TEST_ITEM_COUNT; ++item)
+        {
+            Component *object = pool->Acquire ();
+            *object = prototype;
+            benchmark::DoNotOptimize (object);
+        }
+
+        state.PauseTiming ();
+        delete pool;
+        state.ResumeTiming ();
+    }
+}
+
+template <typename Component>
+void Emplace (benchmark::State &state)
+{
+    const Component prototype = MakePrototype <Component> ();
+    for (auto _ : state)
+    {
+        state.PauseTiming ();
+        auto *pool = new Memory::TypedUnorderedPool <Component> (MEMORY_LIBRARY_PAGE_CAPACITY);
+        state.ResumeTiming ();
+
+        for (std::size_t item = 0u; item < EMPLACE_TEST_ITEM_COUNT; ++item)
+        {
+            Component *object = pool->Emplace (prototype);
+            benchmark::DoNotOptimize (object);
+        }
+
+        state.PauseTiming ();
+        delete pool;
+        state.ResumeTiming ();
+    }
+}
+
+BENCHMARK_TEMPLATE(AcquireAndAssign, Component192b);
+
+BENCHMARK_TEMPLATE(AcquireAndAssign, Component1032b);
+
+BENCHMARK_TEMPLATE(Emplace, Component192b);
+
+BENCHMARK_TEMPLATE(Emplace, Component1032b);
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <Memory/UnorderedPool.hpp>
+#include <Memory/TypedUnorderedPool.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
+#include "DataTypes.hpp"
+#include "ProcessMemory.hpp"
+
+#define FOOTPRINT_TEST_ITEM_COUNT 10000u
+
+// Untyped pools receive entry size from second benchmark argument, typed pools use their entry type size.
+template <typename Pool>
+Memory::SizeType GetEntrySize (const benchmark::State &state)
+{
+    if constexpr (std::is_same_v <typename Pool::ValueType, void>)
+    {
+        return static_cast <Memory::SizeType> (state.range (1));
+    }
+    else
+    {
+        return sizeof (typename Pool::ValueType);
+    }
+}
+
+template <typename Pool>
+Pool *ConstructPool (Memory::SizeType pageCapacity, Memory::SizeType entrySize)
+{
+    if constexpr (std::is_same_v <typename Pool::ValueType, void>)
+    {
+        return new Pool (pageCapacity, entrySize);
+    }
+    else
+    {
+        return new Pool (pageCapacity);
+    }
+}
+
+// Executes the same acquire-free-acquire pattern as AllocateDeallocate benchmark with given page capacity.
+// Reports both throughput and memory usage, so page capacity for each entry type can be selected from data.
+template <typename Pool>
+void MeasureMemoryFootprint (benchmark::State &state, Memory::SizeType pageCapacity, Memory::SizeType entrySize)
+{
+
+    std::vector <decltype (std::declval <Pool &> ().Acquire ())> allocated (FOOTPRINT_TEST_ITEM_COUNT);
+    Memory::SizeType peakPageCount = 0u;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming ();
+        Pool *pool = ConstructPool <Pool> (pageCapacity, entrySize);
+        state.ResumeTiming ();
+
+        for (std::size_t item = 0u; item < FOOTPRINT_TEST_ITEM_COUNT; ++item)
+        {
+            allocated[item] = pool->Acquire ();
+        }
+
+        peakPageCount = std::max (peakPageCount, pool->GetPageCount ());
+        for (std::size_t item = 0u; item < FOOTPRINT_TEST_ITEM_COUNT; item += 2u)
+        {
+            pool->Free (allocated[item]);
+        }
+
+        for (std::size_t item = 0u; item < FOOTPRINT_TEST_ITEM_COUNT / 2u; item += 2u)
+        {
+            allocated[item] = pool->Acquire ();
+        }
+
+        state.PauseTiming ();
+        delete pool;
+        state.ResumeTiming ();
+    }
+
+    // Page layout is page header followed by chunks, see PageDetail::ConstructEmptyPage.
+    const uint64_t pageSize =
+        Memory::PageDetail::PAGE_HEADER_SIZE + static_cast <uint64_t> (pageCapacity) * entrySize;
+    const uint64_t bytesReserved = pageSize * peakPageCount;
+
+    state.SetItemsProcessed (state.iterations () * (FOOTPRINT_TEST_ITEM_COUNT * 7u / 4u));
+    state.counters["PageCount"] = peakPageCount;
+    state.counters["BytesReserved"] = benchmark::Counter (
+        static_cast <double> (bytesReserved), benchmark::Counter::kDefaults, benchmark::Counter::OneK::kIs1024);
+
+    // Ratio between reserved memory and memory, that is actually required to store entries.
+    state.counters["ReservedPerUsed"] =
+        static_cast <double> (bytesReserved) / (static_cast <double> (entrySize) * FOOTPRINT_TEST_ITEM_COUNT);
+
+    state.counters["PeakRSS"] = benchmark::Counter (
+        static_cast <double> (GetPeakResidentSetSize ()), benchmark::Counter::kDefaults,
+        benchmark::Counter::OneK::kIs1024);
+}
+
+// Page capacity is specified by first benchmark argument.
+template <typename Pool>
+void MemoryFootprint (benchmark::State &state)
+{
+    const Memory::SizeType entrySize = GetEntrySize <Pool> (state);
+    MeasureMemoryFootprint <Pool> (state, static_cast <Memory::SizeType> (state.range (0)), entrySize);
+}
+
+// Page size in bytes is specified by first benchmark argument and page capacity is derived from it in the same
+// way as pools do it, when they are constructed from Memory::PageSize.
+template <typename Pool>
+void MemoryFootprintByPageSize (benchmark::State &state)
+{
+    const Memory::SizeType entrySize = GetEntrySize <Pool> (state);
+    MeasureMemoryFootprint <Pool> (
+        state,
+        Memory::PageDetail::CalculatePageCapacity (Memory::PageSize {static_cast <std::size_t> (state.range (0))},
+                                                   entrySize),
+        entrySize);
+}
+
+#define FOOTPRINT_PAGE_CAPACITY_RANGE RangeMultiplier (4)->Range (8, 4096)
+
+#define FOOTPRINT_PAGE_CAPACITY_AND_ENTRY_SIZE_RANGES RangeMultiplier (4)->Ranges ({{8, 4096}, {8, 4096}})
+
+BENCHMARK_TEMPLATE(MemoryFootprint, Memory::TypedUnorderedPool <Component32b>)->FOOTPRINT_PAGE_CAPACITY_RANGE;
+
+BENCHMARK_TEMPLATE(MemoryFootprint, Memory::TypedUnorderedPool <Component192b>)->FOOTPRINT_PAGE_CAPACITY_RANGE;
+
+BENCHMARK_TEMPLATE(MemoryFootprint, Memory::TypedUnorderedPool <Component1032b>)->FOOTPRINT_PAGE_CAPACITY_RANGE;
+
+BENCHMARK_TEMPLATE(MemoryFootprint, Memory::TypedUnorderedTrivialPool <TrivialComponent32b>)
+    ->FOOTPRINT_PAGE_CAPACITY_RANGE;
+
+BENCHMARK_TEMPLATE(MemoryFootprint, Memory::TypedUnorderedTrivialPool <TrivialComponent192b>)
+    ->FOOTPRINT_PAGE_CAPACITY_RANGE;
+
+BENCHMARK_TEMPLATE(MemoryFootprint, Memory::TypedUnorderedTrivialPool <TrivialComponent1032b>)
+    ->FOOTPRINT_PAGE_CAPACITY_RANGE;
+
+BENCHMARK_TEMPLATE(MemoryFootprint, Memory::UnorderedTrivialPool)->FOOTPRINT_PAGE_CAPACITY_AND_ENTRY_SIZE_RANGES;
+
+// From 4 KiB operating system page to 2 MiB huge page.
+#define FOOTPRINT_PAGE_SIZE_RANGE RangeMultiplier (8)->Range (4096, 2097152)
+
+BENCHMARK_TEMPLATE(MemoryFootprintByPageSize, Memory::TypedUnorderedPool <Component192b>)->FOOTPRINT_PAGE_SIZE_RANGE;
+
+BENCHMARK_TEMPLATE(MemoryFootprintByPageSize, Memory::TypedUnorderedPool <Component1032b>)->FOOTPRINT_PAGE_SIZE_RANGE;
@@ -0,0 +1,47 @@
+#include "ProcessMemory.hpp"
+
+#if defined (_WIN32)
+
+#include <windows.h>
+#include <psapi.h>
+
+uint64_t GetPeakResidentSetSize ()
+{
+    PROCESS_MEMORY_COUNTERS counters {};
+    if (GetProcessMemoryInfo (GetCurrentProcess (), &counters, sizeof (counters)))
+    {
+        return counters.PeakWorkingSetSize;
+    }
+
+    return 0u;
+}
+
+#elif defined (__unix__) || defined (__APPLE__)
+
+#include <sys/resource.h>
+
+uint64_t GetPeakResidentSetSize ()
+{
+    rusage usage {};
+    if (getrusage (RUSAGE_SELF, &usage) != 0)
+    {
+        return 0u;
+    }
+
+#if defined (__APPLE__)
+    // On macOS ru_maxrss is already in bytes.
+    return static_cast <uint64_t> (usage.ru_maxrss);
+#else
+    // On Linux and BSD ru_maxrss is measured in kilobytes.
+    return static_cast <uint64_t> (usage.ru_maxrss) * 1024u;
+#endif
+}
+
+#else
+
+uint64_t GetPeakResidentSetSize ()
+{
+    return 0u;
+}
+
+#endif
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstdint>
+
+// Returns peak resident set size of current process in bytes or 0 if it can not be queried on current platform.
+// Keep in mind that this value is process-wide and never decreases, therefore it is only meaningful when
+// benchmarks are executed one by one (for example, using --benchmark_filter) in separate processes.
+uint64_t GetPeakResidentSetSize ();
@@ -0,0 +1,305 @@
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <Memory/CompactUnorderedPool.hpp>
+#include <Memory/Private/VirtualMemory.hpp>
+
+namespace Memory
+{
+CompactUnorderedTrivialPool::CompactUnorderedTrivialPool (SizeType pageCapacity, SizeType chunkSize,
+                                                          CompactFreeListMode mode) noexcept
+    : topPage_ (nullptr),
+      topFreePage_ (nullptr),
+      pageCount_ (0u),
+      pageCapacity_ (0u),
+      chunkSize_ (chunkSize),
+      pageSize_ (CalculatePageSize (pageCapacity, chunkSize, mode)),
+      chunksOffset_ (0u),
+      mode_ (mode),
+      mapsPages_ (pageSize_ >= VirtualMemory::GetPageSize ())
+{
+    assert (pageCapacity > 0u);
+    assert (chunkSize >= MIN_CHUNK_SIZE);
+    pageCapacity_ = CalculatePageCapacity (pageSize_, chunkSize, mode);
+    chunksOffset_ = CalculateChunksOffset (pageCapacity_, mode);
+}
+
+CompactUnorderedTrivialPool::CompactUnorderedTrivialPool (PageSize pageSize, SizeType chunkSize,
+                                                          CompactFreeListMode mode) noexcept
+    : topPage_ (nullptr),
+      topFreePage_ (nullptr),
+      pageCount_ (0u),
+      pageCapacity_ (0u),
+      chunkSize_ (chunkSize),
+      pageSize_ (0u),
+      chunksOffset_ (0u),
+      mode_ (mode),
+      mapsPages_ (false)
+{
+    assert (chunkSize >= MIN_CHUNK_SIZE);
+    assert (pageSize.bytes_ >= CalculatePageSize (1u, chunkSize, mode));
+
+    pageSize_ = 1u;
+    while (pageSize_ * 2u <= pageSize.bytes_)
+    {
+        pageSize_ *= 2u;
+    }
+
+    mapsPages_ = pageSize_ >= VirtualMemory::GetPageSize ();
+
+    pageCapacity_ = CalculatePageCapacity (pageSize_, chunkSize, mode);
+    chunksOffset_ = CalculateChunksOffset (pageCapacity_, mode);
+}
+
+CompactUnorderedTrivialPool::CompactUnorderedTrivialPool (CompactUnorderedTrivialPool &&other) noexcept
+    : topPage_ (other.topPage_),
+      topFreePage_ (other.topFreePage_),
+      pageCount_ (other.pageCount_),
+      pageCapacity_ (other.pageCapacity_),
+      chunkSize_ (other.chunkSize_),
+      pageSize_ (other.pageSize_),
+      chunksOffset_ (other.chunksOffset_),
+      mode_ (other.mode_),
+      mapsPages_ (other.mapsPages_)
+{
+    other.topPage_ = nullptr;
+    other.topFreePage_ = nullptr;
+    other.pageCount_ = 0u;
+}
+
+CompactUnorderedTrivialPool::~CompactUnorderedTrivialPool () noexcept
+{
+    Clean ();
+}
+
+void *CompactUnorderedTrivialPool::Acquire () noexcept
+{
+    if (!topFreePage_)
+    {
+        ConstructPage ();
+    }
+
+    PageHeader *page = topFreePage_;
+    assert (page->freeCount_ > 0u);
+    uint8_t *chunk;
+
+    if (mode_ == CompactFreeListMode::OUT_OF_BAND && page->freeStackSize_ > 0u)
+    {
+        chunk = GetChunk (page, GetFreeStack (page)[--page->freeStackSize_]);
+    }
+    else if (mode_ == CompactFreeListMode::IN_CHUNKS && page->freeHead_ != NO_CHUNK)
+    {
+        chunk = GetChunk (page, page->freeHead_);
+        // Chunk may be not aligned for 16-bit access if chunk size is odd.
+        memcpy (&page->freeHead_, chunk, sizeof (uint16_t));
+    }
+    else
+    {
+        assert (page->initializedCount_ < pageCapacity_);
+        chunk = GetChunk (page, page->initializedCount_++);
+    }
+
+    if (--page->freeCount_ == 0u)
+    {
+        topFreePage_ = page->nextFreePage_;
+        page->nextFreePage_ = nullptr;
+        page->inFreePageList_ = false;
+    }
+
+    return chunk;
+}
+
+void CompactUnorderedTrivialPool::Free (void *entry) noexcept
+{
+    assert (entry);
+    auto *page = reinterpret_cast <PageHeader *> (reinterpret_cast <uintptr_t> (entry) & ~(pageSize_ - 1u));
+    const std::size_t offset = static_cast <uint8_t *> (entry) - GetChunk (page, 0u);
+    assert (offset % chunkSize_ == 0u);
+
+    const auto index = static_cast <uint16_t> (offset / chunkSize_);
+    assert (index < page->initializedCount_);
+
+    if (mode_ == CompactFreeListMode::OUT_OF_BAND)
+    {
+        GetFreeStack (page)[page->freeStackSize_++] = index;
+    }
+    else
+    {
+        memcpy (entry, &page->freeHead_, sizeof (uint16_t));
+        page->freeHead_ = index;
+    }
+
+    ++page->freeCount_;
+
+    if (!page->inFreePageList_)
+    {
+        page->nextFreePage_ = topFreePage_;
+        page->inFreePageList_ = true;
+        topFreePage_ = page;
+    }
+}
+
+void CompactUnorderedTrivialPool::Shrink () noexcept
+{
+    // Both lists are rebuilt without empty pages, order of remaining pages is preserved.
+    PageHeader **pageSlot = &topPage_;
+    while (*pageSlot)
+    {
+        PageHeader *page = *pageSlot;
+        if (page->freeCount_ == pageCapacity_)
+        {
+            *pageSlot = page->nextPage_;
+        }
+        else
+        {
+            pageSlot = &page->nextPage_;
+        }
+    }
+
+    PageHeader **freePageSlot = &topFreePage_;
+    while (*freePageSlot)
+    {
+        PageHeader *page = *freePageSlot;
+        if (page->freeCount_ == pageCapacity_)
+        {
+            *freePageSlot = page->nextFreePage_;
+            FreePage (page);
+            --pageCount_;
+        }
+        else
+        {
+            freePageSlot = &page->nextFreePage_;
+        }
+    }
+}
+
+void CompactUnorderedTrivialPool::Clean () noexcept
+{
+    PageHeader *page = topPage_;
+    while (page)
+    {
+        PageHeader *next = page->nextPage_;
+        FreePage (page);
+        page = next;
+    }
+
+    topPage_ = nullptr;
+    topFreePage_ = nullptr;
+    pageCount_ = 0u;
+}
+
+SizeType CompactUnorderedTrivialPool::GetPageCount () const
+{
+    return pageCount_;
+}
+
+SizeType CompactUnorderedTrivialPool::GetPageCapacity () const
+{
+    return pageCapacity_;
+}
+
+std::size_t CompactUnorderedTrivialPool::GetPageSize () const
+{
+    return pageSize_;
+}
+
+CompactFreeListMode CompactUnorderedTrivialPool::GetFreeListMode () const
+{
+    return mode_;
+}
+
+std::size_t CompactUnorderedTrivialPool::CalculateChunksOffset (SizeType pageCapacity,
+                                                               CompactFreeListMode mode) noexcept
+{
+    if (mode == CompactFreeListMode::IN_CHUNKS)
+    {
+        return PAGE_HEADER_SIZE;
+    }
+
+    const std::size_t stackSize = static_cast <std::size_t> (pageCapacity) * sizeof (uint16_t);
+    return PAGE_HEADER_SIZE + (stackSize + PAGE_HEADER_SIZE - 1u) / PAGE_HEADER_SIZE * PAGE_HEADER_SIZE;
+}
+
+std::size_t CompactUnorderedTrivialPool::CalculatePageSize (SizeType pageCapacity, SizeType chunkSize,
+                                                            CompactFreeListMode mode) noexcept
+{
+    pageCapacity = std::min (pageCapacity, MAX_PAGE_CAPACITY);
+    const std::size_t requiredSize =
+        CalculateChunksOffset (pageCapacity, mode) + static_cast <std::size_t> (pageCapacity) * chunkSize;
+
+    std::size_t pageSize = 1u;
+    while (pageSize < requiredSize)
+    {
+        pageSize *= 2u;
+    }
+
+    return pageSize;
+}
+
+SizeType CompactUnorderedTrivialPool::CalculatePageCapacity (std::size_t pageSize, SizeType chunkSize,
+                                                             CompactFreeListMode mode) noexcept
+{
+    assert (pageSize > PAGE_HEADER_SIZE);
+    const std::size_t chunkCost = mode == CompactFreeListMode::OUT_OF_BAND ? chunkSize + sizeof (uint16_t) : chunkSize;
+    auto pageCapacity = static_cast <SizeType> (
+        std::min <std::size_t> ((pageSize - PAGE_HEADER_SIZE) / chunkCost, MAX_PAGE_CAPACITY));
+
+    // Stack alignment padding may take space of several chunks.
+    while (CalculateChunksOffset (pageCapacity, mode) + static_cast <std::size_t> (pageCapacity) * chunkSize > pageSize)
+    {
+        --pageCapacity;
+    }
+
+    assert (pageCapacity > 0u);
+    return pageCapacity;
+}
+
+uint16_t *CompactUnorderedTrivialPool::GetFreeStack (PageHeader *page) noexcept
+{
+    return reinterpret_cast <uint16_t *> (reinterpret_cast <uint8_t *> (page) + PAGE_HEADER_SIZE);
+}
+
+uint8_t *CompactUnorderedTrivialPool::GetChunk (PageHeader *page, uint16_t index) const noexcept
+{
+    return reinterpret_cast <uint8_t *> (page) + chunksOffset_ + static_cast <std::size_t> (index) * chunkSize_;
+}
+
+void CompactUnorderedTrivialPool::ConstructPage () noexcept
+{
+    // TODO: Handle allocation errors?
+    auto *page = static_cast <PageHeader *> (AllocatePage ());
+    assert (page);
+
+    // Chunks are not linked on construction: they are taken in order through initialized count.
+    page->nextPage_ = topPage_;
+    page->nextFreePage_ = topFreePage_;
+    page->freeHead_ = NO_CHUNK;
+    page->freeStackSize_ = 0u;
+    page->freeCount_ = static_cast <uint16_t> (pageCapacity_);
+    page->initializedCount_ = 0u;
+    page->inFreePageList_ = true;
+
+    topPage_ = page;
+    topFreePage_ = page;
+    ++pageCount_;
+}
+
+void *CompactUnorderedTrivialPool::AllocatePage () const noexcept
+{
+    return mapsPages_ ? VirtualMemory::AllocateAlignedPages (pageSize_, pageSize_) :
+                        VirtualMemory::AllocateAligned (pageSize_, pageSize_);
+}
+
+void CompactUnorderedTrivialPool::FreePage (PageHeader *page) const noexcept
+{
+    if (mapsPages_)
+    {
+        VirtualMemory::FreeAlignedPages (page, pageSize_);
+    }
+    else
+    {
+        VirtualMemory::FreeAligned (page);
+    }
+}
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+#include <Memory/Private/Commons.hpp>
+
+namespace Memory
+{
+// Describes where compact pool stores links of its free lists.
+enum class CompactFreeListMode
+{
+    // Index of next free chunk is written into first 2 bytes of freed chunk.
+    IN_CHUNKS,
+
+    // Every page stores indices of its free chunks in separate stack after page header, so free chunks are never
+    // written by pool and keep their last content. Costs additional 2 bytes per chunk. Useful for type stable memory
+    // techniques, for example, optimistic readers may validate version field of entry, that could be already freed.
+    // Pages are still released by Shrink and Clean, so such readers must not outlive these calls.
+    OUT_OF_BAND,
+};
+
+// Version of UnorderedTrivialPool for tiny entries. Free list of every page is threaded through 16-bit chunk indices
+// instead of pointers, so chunk size can be as small as 2 bytes. Pages are aligned to their size, which is power of
+// two, therefore page of freed chunk is found by masking chunk address. Pages with free chunks are linked into
+// separate list, so Acquire always takes chunk from the first page of this list.
+class CompactUnorderedTrivialPool
+{
+public:
+    using ValueType = void;
+
+    // Chunk indices are 16-bit and one index value marks end of free list.
+    static constexpr SizeType MAX_PAGE_CAPACITY = UINT16_MAX;
+
+    static constexpr SizeType MIN_CHUNK_SIZE = sizeof (uint16_t);
+
+    // Page size is rounded up to power of two and page capacity is increased to fill it.
+    CompactUnorderedTrivialPool (SizeType pageCapacity, SizeType chunkSize,
+                                 CompactFreeListMode mode = CompactFreeListMode::IN_CHUNKS) noexcept;
+
+    // Page size is rounded down to power of two.
+    CompactUnorderedTrivialPool (PageSize pageSize, SizeType chunkSize,
+                                 CompactFreeListMode mode = CompactFreeListMode::IN_CHUNKS) noexcept;
+
+    CompactUnorderedTrivialPool (const CompactUnorderedTrivialPool &other) = delete;
+
+    CompactUnorderedTrivialPool (CompactUnorderedTrivialPool &&other) noexcept;
+
+    ~CompactUnorderedTrivialPool () noexcept;
+
+    void *Acquire () noexcept;
+
+    void Free (void *entry) noexcept;
+
+    // Releases pages without used chunks.
+    void Shrink () noexcept;
+
+    void Clean () noexcept;
+
+    SizeType GetPageCount () const;
+
+    SizeType GetPageCapacity () const;
+
+    // Page size in bytes, page header included.
+    std::size_t GetPageSize () const;
+
+    CompactFreeListMode GetFreeListMode () const;
+
+private:
+    static constexpr uint16_t NO_CHUNK = UINT16_MAX;
+
+    struct PageHeader
+    {
+        PageHeader *nextPage_;
+        PageHeader *nextFreePage_;
+
+        // Used only in in chunks mode.
+        uint16_t freeHead_;
+
+        // Size of free chunk indices stack, used only in out of band mode.
+        uint16_t freeStackSize_;
+
+        // Chunks after initialized count were never acquired, so they are neither in free list nor in stack.
+        uint16_t freeCount_;
+        uint16_t initializedCount_;
+        bool inFreePageList_;
+    };
+
+    // Header size keeps chunks aligned as malloc result.
+    static constexpr std::size_t PAGE_HEADER_SIZE = 32u;
+    static_assert (sizeof (PageHeader) <= PAGE_HEADER_SIZE);
+
+    // Free chunk indices stack of out of band mode is placed right after page header.
+    // Chunks are placed after it with the same alignment as after page header.
+    static std::size_t CalculateChunksOffset (SizeType pageCapacity, CompactFreeListMode mode) noexcept;
+
+    static std::size_t CalculatePageSize (SizeType pageCapacity, SizeType chunkSize, CompactFreeListMode mode) noexcept;
+
+    static SizeType CalculatePageCapacity (std::size_t pageSize, SizeType chunkSize, CompactFreeListMode mode) noexcept;
+
+    static uint16_t *GetFreeStack (PageHeader *page) noexcept;
+
+    uint8_t *GetChunk (PageHeader *page, uint16_t index) const noexcept;
+
+    void ConstructPage () noexcept;
+
+    // Pages not smaller than system page are mapped directly: aligning them on heap wastes up to page size per page.
+    void *AllocatePage () const noexcept;
+
+    void FreePage (PageHeader *page) const noexcept;
+
+    PageHeader *topPage_;
+    PageHeader *topFreePage_;
+    SizeType pageCount_;
+    SizeType pageCapacity_;
+    SizeType chunkSize_;
+    std::size_t pageSize_;
+    std::size_t chunksOffset_;
+    CompactFreeListMode mode_;
+    bool mapsPages_;
+};
+
+// Typed version of CompactUnorderedTrivialPool, that supports trivial entries of any size, starting from 2 bytes.
+template <typename Entry>
+class TypedCompactUnorderedTrivialPool
+{
+    static_assert (std::is_trivial_v <Entry>);
+    static_assert (sizeof (Entry) >= CompactUnorderedTrivialPool::MIN_CHUNK_SIZE,
+                   "Entry type size must be equal or greater than size of 16-bit chunk index!");
+
+public:
+    using ValueType = Entry;
+
+    explicit TypedCompactUnorderedTrivialPool (SizeType pageCapacity,
+                                               CompactFreeListMode mode = CompactFreeListMode::IN_CHUNKS) noexcept;
+
+    explicit TypedCompactUnorderedTrivialPool (PageSize pageSize,
+                                               CompactFreeListMode mode = CompactFreeListMode::IN_CHUNKS) noexcept;
+
+    TypedCompactUnorderedTrivialPool (const TypedCompactUnorderedTrivialPool &other) = delete;
+
+    TypedCompactUnorderedTrivialPool (TypedCompactUnorderedTrivialPool &&other) noexcept = default;
+
+    Entry *Acquire () noexcept;
+
+    void Free (Entry *entry) noexcept;
+
+    void Shrink () noexcept;
+
+    void Clean () noexcept;
+
+    SizeType GetPageCount () const;
+
+    SizeType GetPageCapacity () const;
+
+private:
+    CompactUnorderedTrivialPool pool_;
+};
+
+template <typename Entry>
+TypedCompactUnorderedTrivialPool <Entry>::TypedCompactUnorderedTrivialPool (SizeType pageCapacity,
+                                                                            CompactFreeListMode mode) noexcept
+    : pool_ (pageCapacity, sizeof (Entry), mode)
+{
+}
+
+template <typename Entry>
+TypedCompactUnorderedTrivialPool <Entry>::TypedCompactUnorderedTrivialPool (PageSize pageSize,
+                                                                            CompactFreeListMode mode) noexcept
+    : pool_ (pageSize, sizeof (Entry), mode)
+{
+}
+
+template <typename Entry>
+Entry *TypedCompactUnorderedTrivialPool <Entry>::Acquire () noexcept
+{
+    return static_cast <Entry *> (pool_.Acquire ());
+}
+
+template <typename Entry>
+void TypedCompactUnorderedTrivialPool <Entry>::Free (Entry *entry) noexcept
+{
+    pool_.Free (entry);
+}
+
+template <typename Entry>
+void TypedCompactUnorderedTrivialPool <Entry>::Shrink () noexcept
+{
+    pool_.Shrink ();
+}
+
+template <typename Entry>
+void TypedCompactUnorderedTrivialPool <Entry>::Clean () noexcept
+{
+    pool_.Clean ();
+}
+
+template <typename Entry>
+SizeType TypedCompactUnorderedTrivialPool <Entry>::GetPageCount () const
+{
+    return pool_.GetPageCount ();
+}
+
+template <typename Entry>
+SizeType TypedCompactUnorderedTrivialPool <Entry>::GetPageCapacity () const
+{
+    return pool_.GetPageCapacity ();
+}
+}
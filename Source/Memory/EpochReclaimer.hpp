@@ -0,0 +1,250 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Memory/Private/Commons.hpp>
+
+namespace Memory
+{
+// Epoch based deferred reclamation layer for pools, which entries are used as nodes of lock free structures.
+// Readers access nodes only inside ReadGuard. Unlinked nodes are retired instead of being freed and are returned
+// to pool in batches once every active reader has passed the epoch, in which node was retired. Therefore readers
+// never call pool Free inside ReadGuard and are never blocked by it. Every reader thread uses its own participant
+// index. All pool operations must go through reclaimer, because it serializes access to pool.
+template <typename Pool>
+class EpochReclaimer
+{
+public:
+    using ValueType = typename Pool::ValueType;
+
+    // Marks participant as active reader while guard exists. Guards of one participant must not be nested.
+    class ReadGuard
+    {
+    public:
+        ReadGuard (EpochReclaimer &reclaimer, SizeType participant) noexcept;
+
+        ReadGuard (const ReadGuard &other) = delete;
+
+        ReadGuard (ReadGuard &&other) = delete;
+
+        ~ReadGuard () noexcept;
+
+    private:
+        EpochReclaimer &reclaimer_;
+        SizeType participant_;
+    };
+
+    // Retired entries are collected automatically when there is batchSize of them. If some reader is active at
+    // that moment, collection is deferred until one of readers releases its guard.
+    EpochReclaimer (Pool &pool, SizeType participantCount, SizeType batchSize) noexcept;
+
+    EpochReclaimer (const EpochReclaimer &other) = delete;
+
+    EpochReclaimer (EpochReclaimer &&other) = delete;
+
+    // Frees all retired entries. There must be no active readers.
+    ~EpochReclaimer () noexcept;
+
+    ValueType *Acquire () noexcept;
+
+    // Schedules entry, that is already unlinked from shared structure, for freeing. Can be called inside ReadGuard,
+    // because it never frees entries while any reader is active.
+    void Retire (ValueType *entry) noexcept;
+
+    // Advances epoch if every active reader has observed current one and frees entries, retired two epochs ago.
+    // Returns count of freed entries.
+    SizeType Collect () noexcept;
+
+    SizeType GetRetiredCount () const noexcept;
+
+    uint64_t GetEpoch () const noexcept;
+
+private:
+    // Epoch advances from E to E + 1 only when every active reader has entered in E, therefore entries, retired
+    // in E - 2, are not reachable by any reader. Their list is freed and reused for E + 1, so three lists are enough.
+    static constexpr SizeType EPOCH_LIST_COUNT = 3u;
+
+    static constexpr uint64_t INACTIVE_EPOCH = std::numeric_limits <uint64_t>::max ();
+
+    // Participants are aligned to cache line size, so readers do not invalidate each other caches on enter.
+    struct alignas (64) Participant
+    {
+        std::atomic <uint64_t> epoch_ {INACTIVE_EPOCH};
+    };
+
+    SizeType CollectLocked () noexcept;
+
+    bool HasActiveReaders () const noexcept;
+
+    Pool &pool_;
+    std::atomic <uint64_t> epoch_;
+    std::unique_ptr <Participant []> participants_;
+    SizeType participantCount_;
+    SizeType batchSize_;
+
+    // Guards pool and retired lists.
+    mutable std::mutex mutex_;
+    std::vector <ValueType *> retired_[EPOCH_LIST_COUNT];
+    SizeType retiredCount_;
+
+    // Set by Retire, when batch is full, but collection can not be done, because some reader is active.
+    std::atomic <bool> collectDeferred_;
+};
+
+template <typename Pool>
+EpochReclaimer <Pool>::ReadGuard::ReadGuard (EpochReclaimer &reclaimer, SizeType participant) noexcept
+    : reclaimer_ (reclaimer),
+      participant_ (participant)
+{
+    assert (participant < reclaimer_.participantCount_);
+    std::atomic <uint64_t> &localEpoch = reclaimer_.participants_[participant_].epoch_;
+    assert (localEpoch.load (std::memory_order_relaxed) == INACTIVE_EPOCH);
+
+    // Store alone may be reordered after following node loads. Fence pairs with fence in collector: either collector
+    // sees this reader as active or this reader does not see nodes, that were unlinked before collection.
+    localEpoch.store (reclaimer_.epoch_.load (std::memory_order_acquire), std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+}
+
+template <typename Pool>
+EpochReclaimer <Pool>::ReadGuard::~ReadGuard () noexcept
+{
+    reclaimer_.participants_[participant_].epoch_.store (INACTIVE_EPOCH, std::memory_order_release);
+    if (reclaimer_.collectDeferred_.load (std::memory_order_relaxed))
+    {
+        // Reader must not be blocked by writers, so deferred collection is left to them if lock is taken.
+        std::unique_lock <std::mutex> lock (reclaimer_.mutex_, std::try_to_lock);
+        if (lock.owns_lock () && reclaimer_.collectDeferred_.exchange (false, std::memory_order_relaxed))
+        {
+            reclaimer_.CollectLocked ();
+        }
+    }
+}
+
+template <typename Pool>
+EpochReclaimer <Pool>::EpochReclaimer (Pool &pool, SizeType participantCount, SizeType batchSize) noexcept
+    : pool_ (pool),
+      epoch_ (0u),
+      participants_ (new Participant[participantCount]),
+      participantCount_ (participantCount),
+      batchSize_ (batchSize),
+      mutex_ (),
+      retired_ (),
+      retiredCount_ (0u),
+      collectDeferred_ (false)
+{
+    assert (participantCount > 0u);
+    assert (batchSize > 0u);
+}
+
+template <typename Pool>
+EpochReclaimer <Pool>::~EpochReclaimer () noexcept
+{
+    for (std::vector <ValueType *> &list : retired_)
+    {
+        for (ValueType *entry : list)
+        {
+            pool_.Free (entry);
+        }
+    }
+}
+
+template <typename Pool>
+typename EpochReclaimer <Pool>::ValueType *EpochReclaimer <Pool>::Acquire () noexcept
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    return pool_.Acquire ();
+}
+
+template <typename Pool>
+void EpochReclaimer <Pool>::Retire (ValueType *entry) noexcept
+{
+    assert (entry);
+    std::lock_guard <std::mutex> lock (mutex_);
+    retired_[epoch_.load (std::memory_order_relaxed) % EPOCH_LIST_COUNT].push_back (entry);
+
+    if (++retiredCount_ >= batchSize_)
+    {
+        // Caller may be inside ReadGuard, but only if its participant is active.
+        if (HasActiveReaders ())
+        {
+            collectDeferred_.store (true, std::memory_order_relaxed);
+        }
+        else
+        {
+            CollectLocked ();
+        }
+    }
+}
+
+template <typename Pool>
+SizeType EpochReclaimer <Pool>::Collect () noexcept
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    return CollectLocked ();
+}
+
+template <typename Pool>
+SizeType EpochReclaimer <Pool>::GetRetiredCount () const noexcept
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    return retiredCount_;
+}
+
+template <typename Pool>
+uint64_t EpochReclaimer <Pool>::GetEpoch () const noexcept
+{
+    return epoch_.load (std::memory_order_acquire);
+}
+
+template <typename Pool>
+SizeType EpochReclaimer <Pool>::CollectLocked () noexcept
+{
+    // Pairs with fence in ReadGuard. Epoch is changed only under lock, therefore relaxed load is enough.
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    const uint64_t epoch = epoch_.load (std::memory_order_relaxed);
+
+    for (SizeType index = 0u; index < participantCount_; ++index)
+    {
+        const uint64_t localEpoch = participants_[index].epoch_.load (std::memory_order_acquire);
+        if (localEpoch != INACTIVE_EPOCH && localEpoch != epoch)
+        {
+            return 0u;
+        }
+    }
+
+    epoch_.store (epoch + 1u, std::memory_order_release);
+    std::vector <ValueType *> &list = retired_[(epoch + 1u) % EPOCH_LIST_COUNT];
+    const auto freedCount = static_cast <SizeType> (list.size ());
+
+    for (ValueType *entry : list)
+    {
+        pool_.Free (entry);
+    }
+
+    list.clear ();
+    retiredCount_ -= freedCount;
+    return freedCount;
+}
+
+template <typename Pool>
+bool EpochReclaimer <Pool>::HasActiveReaders () const noexcept
+{
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    for (SizeType index = 0u; index < participantCount_; ++index)
+    {
+        if (participants_[index].epoch_.load (std::memory_order_acquire) != INACTIVE_EPOCH)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+}
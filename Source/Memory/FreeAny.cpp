@@ -0,0 +1,13 @@
+#include <Memory/FreeAny.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
+namespace Memory
+{
+void FreeAny (void *entry) noexcept
+{
+    if (entry)
+    {
+        PoolDetail::FreeOwnedEntry (entry);
+    }
+}
+}
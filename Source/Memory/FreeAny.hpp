@@ -0,0 +1,9 @@
+#pragma once
+
+namespace Memory
+{
+// Frees entry of any pool with enabled owner lookup (see EnableOwnerLookup of pools) in O(1). Owner pool is found
+// through owner header of aligned page block, that contains entry, and entry is freed by owner Free, so destructor
+// is called if pool has one. Behaviour is undefined for other pointers, including entries of pools without lookup.
+void FreeAny (void *entry) noexcept;
+}
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+
+#include <Memory/MonotonicArena.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
+namespace Memory
+{
+MonotonicArena::Scope::Scope (MonotonicArena &arena) noexcept
+    : arena_ (arena),
+      marker_ (arena.GetMarker ())
+{
+}
+
+MonotonicArena::Scope::~Scope () noexcept
+{
+    arena_.Rewind (marker_);
+}
+
+MonotonicArena::MonotonicArena (SizeType pageCapacity) noexcept
+    : fields_ (BasePoolFields::ForEmptyPool (pageCapacity)),
+      currentPage_ (nullptr),
+      currentOffset_ (0u)
+{
+    assert (pageCapacity > 0u);
+}
+
+MonotonicArena::MonotonicArena (PageSize pageSize) noexcept
+    : MonotonicArena (CalculatePageCapacity (pageSize))
+{
+}
+
+MonotonicArena::MonotonicArena (MonotonicArena &&other) noexcept
+    : fields_ (other.fields_),
+      currentPage_ (other.currentPage_),
+      currentOffset_ (other.currentOffset_)
+{
+    other.fields_ = BasePoolFields::ForEmptyPool (fields_.pageCapacity_);
+    other.currentPage_ = nullptr;
+    other.currentOffset_ = 0u;
+}
+
+MonotonicArena::~MonotonicArena () noexcept
+{
+    Clean ();
+}
+
+void *MonotonicArena::Allocate (std::size_t size, std::size_t alignment) noexcept
+{
+    assert (alignment > 0u && (alignment & (alignment - 1u)) == 0u);
+    if (currentPage_)
+    {
+        if (void *result = TryAllocate (currentPage_, currentOffset_, size, alignment))
+        {
+            return result;
+        }
+
+        // Pages after current one are left from previous frames and can be reused.
+        PagePointer next = PageDetail::NextPage (currentPage_);
+        std::size_t offset = 0u;
+
+        if (next)
+        {
+            if (void *result = TryAllocate (next, offset, size, alignment))
+            {
+                currentPage_ = next;
+                currentOffset_ = offset;
+                return result;
+            }
+        }
+    }
+
+    // Page is inserted right after current one, therefore pages, that are left for reuse, stay after it.
+    const std::size_t requiredCapacity = size + alignment - 1u;
+    const auto pageCapacity = static_cast <SizeType> (
+        std::max <std::size_t> (fields_.pageCapacity_, requiredCapacity));
+    assert (pageCapacity >= requiredCapacity);
+
+    PagePointer page = PageDetail::AllocatePage (pageCapacity, 1u);
+    if (currentPage_)
+    {
+        PageDetail::SetNextPage (page, PageDetail::NextPage (currentPage_));
+        PageDetail::SetNextPage (currentPage_, page);
+    }
+    else
+    {
+        PageDetail::SetNextPage (page, fields_.topPage_);
+        fields_.topPage_ = page;
+    }
+
+    ++fields_.pageCount_;
+    currentPage_ = page;
+    currentOffset_ = 0u;
+
+    void *result = TryAllocate (currentPage_, currentOffset_, size, alignment);
+    assert (result);
+    return result;
+}
+
+MonotonicArena::Marker MonotonicArena::GetMarker () const noexcept
+{
+    return {currentPage_, currentOffset_};
+}
+
+void MonotonicArena::Rewind (const Marker &marker) noexcept
+{
+    // Marker without page was taken before first allocation.
+    if (!marker.page_)
+    {
+        Reset ();
+        return;
+    }
+
+    assert (std::find (PageDetail::PageIterator::Begin (fields_), PageDetail::PageIterator::End (fields_),
+                       marker.page_) != PageDetail::PageIterator::End (fields_));
+    assert (marker.offset_ <= PageDetail::GetCapacity (marker.page_));
+
+    currentPage_ = marker.page_;
+    currentOffset_ = marker.offset_;
+}
+
+void MonotonicArena::Reset () noexcept
+{
+    currentPage_ = fields_.topPage_;
+    currentOffset_ = 0u;
+}
+
+void MonotonicArena::Clean () noexcept
+{
+    PageDetail::PageIterator iterator = PageDetail::PageIterator::Begin (fields_);
+    const PageDetail::PageIterator end = PageDetail::PageIterator::End (fields_);
+
+    while (iterator != end)
+    {
+        PagePointer page = *iterator;
+        ++iterator;
+        free (page);
+    }
+
+    fields_.topPage_ = nullptr;
+    fields_.pageCount_ = 0u;
+    currentPage_ = nullptr;
+    currentOffset_ = 0u;
+}
+
+SizeType MonotonicArena::GetPageCount () const
+{
+    return fields_.pageCount_;
+}
+
+SizeType MonotonicArena::GetPageCapacity () const
+{
+    return fields_.pageCapacity_;
+}
+
+SizeType MonotonicArena::CalculatePageCapacity (PageSize pageSize) noexcept
+{
+    // Same rule as in PageDetail::CalculatePageCapacity, but capacity is counted in bytes.
+    const std::size_t headersSize = PageDetail::PAGE_HEADER_SIZE + PageDetail::ALLOCATION_OVERHEAD;
+    assert (pageSize.bytes_ > headersSize);
+
+    // Assert above is not checked in release builds, so size is compared before subtraction to avoid underflow.
+    if (pageSize.bytes_ <= headersSize)
+    {
+        return 1u;
+    }
+
+    return static_cast <SizeType> (pageSize.bytes_ - headersSize);
+}
+
+void *MonotonicArena::TryAllocate (PagePointer page, std::size_t &offset, std::size_t size,
+                                   std::size_t alignment) noexcept
+{
+    const auto begin = reinterpret_cast <uintptr_t> (PageDetail::GetFirstChunk (page));
+    const uintptr_t end = begin + PageDetail::GetCapacity (page);
+    const uintptr_t address = (begin + offset + alignment - 1u) & ~static_cast <uintptr_t> (alignment - 1u);
+
+    if (address > end || end - address < size)
+    {
+        return nullptr;
+    }
+
+    offset = address + size - begin;
+    return reinterpret_cast <void *> (address);
+}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Memory/Private/Commons.hpp>
+
+namespace Memory
+{
+// Bump allocator for temporary data, that uses the same page list as pools. Memory is never freed separately:
+// arena is either rewound to marker or reset. Both operations are O(1) and keep pages for reuse.
+class MonotonicArena
+{
+public:
+    // Position inside arena. Everything, that was allocated after marker was taken, is discarded by rewind.
+    struct Marker
+    {
+        PagePointer page_ = nullptr;
+        std::size_t offset_ = 0u;
+    };
+
+    // Rewinds arena to the position, where scope was created, when scope is destroyed.
+    class Scope
+    {
+    public:
+        explicit Scope (MonotonicArena &arena) noexcept;
+
+        Scope (const Scope &other) = delete;
+
+        Scope (Scope &&other) = delete;
+
+        ~Scope () noexcept;
+
+    private:
+        MonotonicArena &arena_;
+        Marker marker_;
+    };
+
+    // Page capacity is given in bytes. Allocations, that do not fit into page, receive separate bigger page.
+    explicit MonotonicArena (SizeType pageCapacity) noexcept;
+
+    // Page capacity is page size without page header and malloc header, but not less than 1 byte.
+    explicit MonotonicArena (PageSize pageSize) noexcept;
+
+    MonotonicArena (const MonotonicArena &other) = delete;
+
+    MonotonicArena (MonotonicArena &&other) noexcept;
+
+    ~MonotonicArena () noexcept;
+
+    void *Allocate (std::size_t size, std::size_t alignment = alignof (std::max_align_t)) noexcept;
+
+    Marker GetMarker () const noexcept;
+
+    void Rewind (const Marker &marker) noexcept;
+
+    // Discards all allocations, but keeps pages, so next frame allocations do not hit allocator.
+    void Reset () noexcept;
+
+    // Discards all allocations and frees all pages.
+    void Clean () noexcept;
+
+    SizeType GetPageCount () const;
+
+    SizeType GetPageCapacity () const;
+
+private:
+    static SizeType CalculatePageCapacity (PageSize pageSize) noexcept;
+
+    // Allocates from given page starting from given offset. Returns nullptr if there is not enough space.
+    static void *TryAllocate (PagePointer page, std::size_t &offset, std::size_t size, std::size_t alignment) noexcept;
+
+    BasePoolFields fields_;
+    PagePointer currentPage_;
+    std::size_t currentOffset_;
+};
+}
@@ -0,0 +1,95 @@
+#include <cassert>
+#include <cstdlib>
+
+#include <Memory/PageDepot.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
+namespace Memory
+{
+PageDepot::PageDepot (std::size_t capacity) noexcept
+    : mutex_ (),
+      pagesBySize_ (),
+      size_ (0u),
+      capacity_ (capacity),
+      pageCount_ (0u)
+{
+}
+
+PageDepot::~PageDepot () noexcept
+{
+    Clean ();
+}
+
+bool PageDepot::Deposit (PagePointer page, std::size_t pageSize) noexcept
+{
+    assert (page);
+    assert (pageSize > PageDetail::PAGE_HEADER_SIZE);
+    std::lock_guard <std::mutex> lock (mutex_);
+
+    if (capacity_ - size_ < pageSize)
+    {
+        return false;
+    }
+
+    PagePointer &top = pagesBySize_[pageSize];
+    PageDetail::SetNextPage (page, top);
+    top = page;
+
+    size_ += pageSize;
+    ++pageCount_;
+    return true;
+}
+
+PagePointer PageDepot::Withdraw (std::size_t pageSize) noexcept
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    auto iterator = pagesBySize_.find (pageSize);
+
+    if (iterator == pagesBySize_.end () || !iterator->second)
+    {
+        return nullptr;
+    }
+
+    PagePointer page = iterator->second;
+    iterator->second = PageDetail::NextPage (page);
+
+    size_ -= pageSize;
+    --pageCount_;
+    return page;
+}
+
+void PageDepot::Clean () noexcept
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    for (auto &[pageSize, top] : pagesBySize_)
+    {
+        while (top)
+        {
+            PagePointer page = top;
+            top = PageDetail::NextPage (page);
+            free (page);
+        }
+    }
+
+    pagesBySize_.clear ();
+    size_ = 0u;
+    pageCount_ = 0u;
+}
+
+std::size_t PageDepot::GetSize () const noexcept
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    return size_;
+}
+
+std::size_t PageDepot::GetCapacity () const noexcept
+{
+    return capacity_;
+}
+
+SizeType PageDepot::GetPageCount () const noexcept
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    return pageCount_;
+}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+#include <Memory/Private/Commons.hpp>
+
+namespace Memory
+{
+// Thread safe storage of free pages, that can be shared by several pools. Pools deposit pages, released by
+// shrink or clean, and withdraw pages with the same byte size instead of allocating new ones. Therefore pages,
+// released by one pool, are reused by other pools with the same page size without allocator calls.
+// Depot must outlive every pool, that uses it.
+class PageDepot
+{
+public:
+    // Capacity is maximum total size of stored pages in bytes. Pages, that do not fit, are freed by pools.
+    explicit PageDepot (std::size_t capacity) noexcept;
+
+    PageDepot (const PageDepot &other) = delete;
+
+    PageDepot (PageDepot &&other) = delete;
+
+    ~PageDepot () noexcept;
+
+    // Takes ownership of given page if there is enough space for it. Page must be allocated by malloc.
+    bool Deposit (PagePointer page, std::size_t pageSize) noexcept;
+
+    // Returns stored page with given size or nullptr if there is no such page.
+    PagePointer Withdraw (std::size_t pageSize) noexcept;
+
+    // Frees all stored pages.
+    void Clean () noexcept;
+
+    std::size_t GetSize () const noexcept;
+
+    std::size_t GetCapacity () const noexcept;
+
+    SizeType GetPageCount () const noexcept;
+
+private:
+    mutable std::mutex mutex_;
+
+    // Stored pages are linked through page header, so only list top is stored for each page size.
+    std::unordered_map <std::size_t, PagePointer> pagesBySize_;
+    std::size_t size_;
+    std::size_t capacity_;
+    SizeType pageCount_;
+};
+}
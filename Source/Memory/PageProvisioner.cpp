@@ -0,0 +1,130 @@
+#include <cassert>
+#include <cstdlib>
+
+#include <Memory/PageProvisioner.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
+namespace Memory
+{
+PageProvisioner::PageProvisioner (SizeType pageCapacity, SizeType chunkSize,
+                                  SizeType lowWatermark, SizeType highWatermark) noexcept
+    : pageCapacity_ (pageCapacity),
+      chunkSize_ (chunkSize),
+      lowWatermark_ (lowWatermark),
+      highWatermark_ (highWatermark),
+      mutex_ (),
+      replenishRequested_ (),
+      replenished_ (),
+      readyPages_ (nullptr),
+      readyPageCount_ (0u),
+      stopRequested_ (false),
+      thread_ (&PageProvisioner::Run, this)
+{
+    assert (pageCapacity > 0u);
+    assert (chunkSize >= sizeof (uintptr_t));
+    assert (lowWatermark <= highWatermark);
+    assert (highWatermark > 0u);
+}
+
+PageProvisioner::~PageProvisioner () noexcept
+{
+    {
+        std::lock_guard <std::mutex> lock (mutex_);
+        stopRequested_ = true;
+    }
+
+    replenishRequested_.notify_one ();
+    thread_.join ();
+
+    while (readyPages_)
+    {
+        PagePointer page = readyPages_;
+        readyPages_ = PageDetail::NextPage (page);
+        free (page);
+    }
+}
+
+PagePointer PageProvisioner::Take (SizeType pageCapacity) noexcept
+{
+    if (pageCapacity != pageCapacity_)
+    {
+        return nullptr;
+    }
+
+    std::unique_lock <std::mutex> lock (mutex_);
+    if (!readyPages_)
+    {
+        // Reserve was exhausted faster than thread was able to replenish it, pool will allocate page itself.
+        replenishRequested_.notify_one ();
+        return nullptr;
+    }
+
+    PagePointer page = readyPages_;
+    readyPages_ = PageDetail::NextPage (page);
+    PageDetail::SetNextPage (page, nullptr);
+    --readyPageCount_;
+
+    if (readyPageCount_ < lowWatermark_)
+    {
+        lock.unlock ();
+        replenishRequested_.notify_one ();
+    }
+
+    return page;
+}
+
+void PageProvisioner::WaitUntilFull () noexcept
+{
+    std::unique_lock <std::mutex> lock (mutex_);
+    replenished_.wait (lock, [this] ()
+    {
+        return readyPageCount_ >= highWatermark_;
+    });
+}
+
+SizeType PageProvisioner::GetReadyPageCount () const noexcept
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    return readyPageCount_;
+}
+
+SizeType PageProvisioner::GetPageCapacity () const noexcept
+{
+    return pageCapacity_;
+}
+
+SizeType PageProvisioner::GetChunkSize () const noexcept
+{
+    return chunkSize_;
+}
+
+void PageProvisioner::Run () noexcept
+{
+    std::unique_lock <std::mutex> lock (mutex_);
+    while (true)
+    {
+        // Reserve is filled to high watermark, so thread is not woken up after every taken page.
+        while (!stopRequested_ && readyPageCount_ < highWatermark_)
+        {
+            lock.unlock ();
+            PagePointer page = PageDetail::ConstructEmptyPage (pageCapacity_, chunkSize_);
+            lock.lock ();
+
+            PageDetail::SetNextPage (page, readyPages_);
+            readyPages_ = page;
+            ++readyPageCount_;
+        }
+
+        replenished_.notify_all ();
+        if (stopRequested_)
+        {
+            return;
+        }
+
+        replenishRequested_.wait (lock, [this] ()
+        {
+            return stopRequested_ || readyPageCount_ < lowWatermark_ || !readyPages_;
+        });
+    }
+}
+}
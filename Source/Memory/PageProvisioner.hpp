@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <Memory/Private/Commons.hpp>
+
+namespace Memory
+{
+// Keeps reserve of ready pages with fixed capacity and chunk size, which chunks are already linked into free list.
+// Background thread constructs new pages when count of ready pages drops below low watermark, therefore pool, that
+// runs out of free chunks, takes ready page instead of allocating and initializing it on the critical path.
+// Provisioner must outlive every pool, that uses it.
+class PageProvisioner
+{
+public:
+    // Background thread starts immediately and fills reserve up to high watermark.
+    PageProvisioner (SizeType pageCapacity, SizeType chunkSize,
+                     SizeType lowWatermark, SizeType highWatermark) noexcept;
+
+    PageProvisioner (const PageProvisioner &other) = delete;
+
+    PageProvisioner (PageProvisioner &&other) = delete;
+
+    // Stops background thread and frees all ready pages.
+    ~PageProvisioner () noexcept;
+
+    // Returns ready page or nullptr if reserve is empty or requested capacity differs from provisioner one.
+    PagePointer Take (SizeType pageCapacity) noexcept;
+
+    // Blocks until reserve is filled up to high watermark. Useful before heavy loading or in tests.
+    void WaitUntilFull () noexcept;
+
+    SizeType GetReadyPageCount () const noexcept;
+
+    SizeType GetPageCapacity () const noexcept;
+
+    SizeType GetChunkSize () const noexcept;
+
+private:
+    void Run () noexcept;
+
+    const SizeType pageCapacity_;
+    const SizeType chunkSize_;
+    const SizeType lowWatermark_;
+    const SizeType highWatermark_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable replenishRequested_;
+    std::condition_variable replenished_;
+
+    PagePointer readyPages_;
+    SizeType readyPageCount_;
+    bool stopRequested_;
+
+    // Thread is declared last, so it starts after all other fields are initialized.
+    std::thread thread_;
+};
+}
@@ -0,0 +1,45 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <Memory/ParallelExecutor.hpp>
+
+namespace Memory
+{
+void ThreadParallelExecutor (SizeType taskCount, const ParallelTask &task)
+{
+    if (taskCount == 0u)
+    {
+        return;
+    }
+
+    std::atomic <SizeType> nextTaskIndex {0u};
+    auto worker = [&nextTaskIndex, taskCount, &task] ()
+    {
+        SizeType taskIndex;
+        while ((taskIndex = nextTaskIndex.fetch_add (1u, std::memory_order_relaxed)) < taskCount)
+        {
+            task (taskIndex);
+        }
+    };
+
+    // Current thread also executes tasks, therefore one thread less is required.
+    const SizeType threadCount =
+        std::min <SizeType> (taskCount, std::max (std::thread::hardware_concurrency (), 1u)) - 1u;
+
+    std::vector <std::thread> threads;
+    threads.reserve (threadCount);
+
+    for (SizeType threadIndex = 0u; threadIndex < threadCount; ++threadIndex)
+    {
+        threads.emplace_back (worker);
+    }
+
+    worker ();
+    for (std::thread &thread : threads)
+    {
+        thread.join ();
+    }
+}
+}
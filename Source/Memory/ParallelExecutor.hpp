@@ -0,0 +1,18 @@
+#pragma once
+
+#include <functional>
+
+#include <Memory/Private/Commons.hpp>
+
+namespace Memory
+{
+using ParallelTask = std::function <void (SizeType taskIndex)>;
+
+// Executes task for every index in [0, taskCount) range, possibly in parallel, and returns only after all
+// tasks are finished. Allows pools to use any user thread pool or job system for heavy operations.
+using ParallelExecutor = std::function <void (SizeType taskCount, const ParallelTask &task)>;
+
+// Built-in executor, that distributes tasks between temporary threads (one per hardware thread).
+// Creates threads on every call, therefore it is only suitable for rare heavy operations like world unload.
+void ThreadParallelExecutor (SizeType taskCount, const ParallelTask &task);
+}
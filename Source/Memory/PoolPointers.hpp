@@ -0,0 +1,289 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+#include <Memory/Private/Commons.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
+namespace Memory
+{
+// Unique owner of entry of typed pool with enabled owner lookup. Pool is found through page header when entry is
+// freed, therefore pointer has the same size as raw pointer.
+template <typename Entry>
+class PoolUniquePtr
+{
+public:
+    PoolUniquePtr () noexcept = default;
+
+    explicit PoolUniquePtr (Entry *entry) noexcept;
+
+    PoolUniquePtr (const PoolUniquePtr &other) = delete;
+
+    PoolUniquePtr (PoolUniquePtr &&other) noexcept;
+
+    ~PoolUniquePtr () noexcept;
+
+    PoolUniquePtr &operator = (const PoolUniquePtr &other) = delete;
+
+    PoolUniquePtr &operator = (PoolUniquePtr &&other) noexcept;
+
+    Entry *Get () const noexcept;
+
+    // Returns entry without freeing it. Caller becomes responsible for freeing.
+    Entry *Release () noexcept;
+
+    // Frees current entry and takes ownership of given one.
+    void Reset (Entry *entry = nullptr) noexcept;
+
+    Entry &operator * () const noexcept;
+
+    Entry *operator -> () const noexcept;
+
+    explicit operator bool () const noexcept;
+
+private:
+    Entry *entry_ = nullptr;
+};
+
+// Base for entries, that are owned by PoolSharedPtr. Reference counter is stored inside entry, therefore
+// shared pointer has the same size as raw pointer and does not allocate control block.
+class PoolSharedEntry
+{
+private:
+    template <typename Entry>
+    friend class PoolSharedPtr;
+
+    std::atomic <SizeType> referenceCount_ {0u};
+};
+
+// Shared owner of entry of typed pool with enabled owner lookup. Entry is freed to its pool when last owner is lost.
+template <typename Entry>
+class PoolSharedPtr
+{
+    static_assert (std::is_base_of_v <PoolSharedEntry, Entry>, "Entry must be derived from PoolSharedEntry!");
+
+public:
+    PoolSharedPtr () noexcept = default;
+
+    explicit PoolSharedPtr (Entry *entry) noexcept;
+
+    PoolSharedPtr (const PoolSharedPtr &other) noexcept;
+
+    PoolSharedPtr (PoolSharedPtr &&other) noexcept;
+
+    ~PoolSharedPtr () noexcept;
+
+    PoolSharedPtr &operator = (const PoolSharedPtr &other) noexcept;
+
+    PoolSharedPtr &operator = (PoolSharedPtr &&other) noexcept;
+
+    Entry *Get () const noexcept;
+
+    // Drops current reference and references given entry.
+    void Reset (Entry *entry = nullptr) noexcept;
+
+    SizeType GetReferenceCount () const noexcept;
+
+    Entry &operator * () const noexcept;
+
+    Entry *operator -> () const noexcept;
+
+    explicit operator bool () const noexcept;
+
+private:
+    static void AddReference (Entry *entry) noexcept;
+
+    static void RemoveReference (Entry *entry) noexcept;
+
+    Entry *entry_ = nullptr;
+};
+
+template <typename Entry>
+PoolUniquePtr <Entry>::PoolUniquePtr (Entry *entry) noexcept
+    : entry_ (entry)
+{
+}
+
+template <typename Entry>
+PoolUniquePtr <Entry>::PoolUniquePtr (PoolUniquePtr &&other) noexcept
+    : entry_ (other.Release ())
+{
+}
+
+template <typename Entry>
+PoolUniquePtr <Entry>::~PoolUniquePtr () noexcept
+{
+    Reset ();
+}
+
+template <typename Entry>
+PoolUniquePtr <Entry> &PoolUniquePtr <Entry>::operator = (PoolUniquePtr &&other) noexcept
+{
+    if (this != &other)
+    {
+        Reset (other.Release ());
+    }
+
+    return *this;
+}
+
+template <typename Entry>
+Entry *PoolUniquePtr <Entry>::Get () const noexcept
+{
+    return entry_;
+}
+
+template <typename Entry>
+Entry *PoolUniquePtr <Entry>::Release () noexcept
+{
+    Entry *entry = entry_;
+    entry_ = nullptr;
+    return entry;
+}
+
+template <typename Entry>
+void PoolUniquePtr <Entry>::Reset (Entry *entry) noexcept
+{
+    Entry *previous = entry_;
+    entry_ = entry;
+
+    if (previous)
+    {
+        PoolDetail::FreeOwnedEntry (previous);
+    }
+}
+
+template <typename Entry>
+Entry &PoolUniquePtr <Entry>::operator * () const noexcept
+{
+    assert (entry_);
+    return *entry_;
+}
+
+template <typename Entry>
+Entry *PoolUniquePtr <Entry>::operator -> () const noexcept
+{
+    assert (entry_);
+    return entry_;
+}
+
+template <typename Entry>
+PoolUniquePtr <Entry>::operator bool () const noexcept
+{
+    return entry_;
+}
+
+template <typename Entry>
+PoolSharedPtr <Entry>::PoolSharedPtr (Entry *entry) noexcept
+    : entry_ (entry)
+{
+    AddReference (entry_);
+}
+
+template <typename Entry>
+PoolSharedPtr <Entry>::PoolSharedPtr (const PoolSharedPtr &other) noexcept
+    : entry_ (other.entry_)
+{
+    AddReference (entry_);
+}
+
+template <typename Entry>
+PoolSharedPtr <Entry>::PoolSharedPtr (PoolSharedPtr &&other) noexcept
+    : entry_ (other.entry_)
+{
+    other.entry_ = nullptr;
+}
+
+template <typename Entry>
+PoolSharedPtr <Entry>::~PoolSharedPtr () noexcept
+{
+    RemoveReference (entry_);
+}
+
+template <typename Entry>
+PoolSharedPtr <Entry> &PoolSharedPtr <Entry>::operator = (const PoolSharedPtr &other) noexcept
+{
+    // Reference is added before removal, so self assignment does not free entry.
+    AddReference (other.entry_);
+    RemoveReference (entry_);
+    entry_ = other.entry_;
+    return *this;
+}
+
+template <typename Entry>
+PoolSharedPtr <Entry> &PoolSharedPtr <Entry>::operator = (PoolSharedPtr &&other) noexcept
+{
+    if (this != &other)
+    {
+        RemoveReference (entry_);
+        entry_ = other.entry_;
+        other.entry_ = nullptr;
+    }
+
+    return *this;
+}
+
+template <typename Entry>
+Entry *PoolSharedPtr <Entry>::Get () const noexcept
+{
+    return entry_;
+}
+
+template <typename Entry>
+void PoolSharedPtr <Entry>::Reset (Entry *entry) noexcept
+{
+    AddReference (entry);
+    RemoveReference (entry_);
+    entry_ = entry;
+}
+
+template <typename Entry>
+SizeType PoolSharedPtr <Entry>::GetReferenceCount () const noexcept
+{
+    return entry_ ? static_cast <const PoolSharedEntry *> (entry_)->referenceCount_.load (
+        std::memory_order_relaxed) : 0u;
+}
+
+template <typename Entry>
+Entry &PoolSharedPtr <Entry>::operator * () const noexcept
+{
+    assert (entry_);
+    return *entry_;
+}
+
+template <typename Entry>
+Entry *PoolSharedPtr <Entry>::operator -> () const noexcept
+{
+    assert (entry_);
+    return entry_;
+}
+
+template <typename Entry>
+PoolSharedPtr <Entry>::operator bool () const noexcept
+{
+    return entry_;
+}
+
+template <typename Entry>
+void PoolSharedPtr <Entry>::AddReference (Entry *entry) noexcept
+{
+    if (entry)
+    {
+        static_cast <PoolSharedEntry *> (entry)->referenceCount_.fetch_add (1u, std::memory_order_relaxed);
+    }
+}
+
+template <typename Entry>
+void PoolSharedPtr <Entry>::RemoveReference (Entry *entry) noexcept
+{
+    // Acquire-release decrement makes all writes of other owners visible to the thread, that frees entry.
+    if (entry &&
+        static_cast <PoolSharedEntry *> (entry)->referenceCount_.fetch_sub (1u, std::memory_order_acq_rel) == 1u)
+    {
+        PoolDetail::FreeOwnedEntry (entry);
+    }
+}
+}
@@ -2,13 +2,35 @@
 
 namespace Memory
 {
+PageReleasePolicy PageReleasePolicy::Never ()
+{
+    return {0u, std::numeric_limits <SizeType>::max ()};
+}
+
+PageReleasePolicy PageReleasePolicy::KeepSpare (SizeType sparePageCount)
+{
+    return {sparePageCount, sparePageCount + 1u};
+}
+
+PageReleasePolicy PageReleasePolicy::ReleaseAfter (SizeType emptyPageCount)
+{
+    return {0u, emptyPageCount};
+}
+
+bool PageReleasePolicy::IsNever () const noexcept
+{
+    return releaseThreshold_ == std::numeric_limits <SizeType>::max ();
+}
+
 BasePoolFields Memory::BasePoolFields::ForEmptyPool (SizeType pageCapacity)
 {
-    return {nullptr, nullptr, 0u, pageCapacity};
+    return {nullptr, nullptr, 0u, pageCapacity, pageCapacity,
+            nullptr, nullptr, PageReleasePolicy::Never (), nullptr, nullptr, nullptr, ReleasedPageMode::FREE,
+            nullptr, nullptr, PageOwner {}};
 }
 
 UntypedPoolFields UntypedPoolFields::ForEmptyPool (SizeType pageCapacity, SizeType chunkSize)
 {
-    return {nullptr, nullptr, 0u, pageCapacity, chunkSize};
+    return {BasePoolFields::ForEmptyPool (pageCapacity), chunkSize};
 }
 }
\ No newline at end of file
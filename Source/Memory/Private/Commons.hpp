@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 
 namespace Memory
 {
@@ -11,6 +13,70 @@ using SizeType = uint32_t;
 using PagePointer = void *;
 using ChunkPointer = void *;
 
+class PageDepot;
+
+class PageProvisioner;
+
+namespace PoolDetail
+{
+struct PagePassState;
+
+struct PageUsageState;
+
+struct ReservedBlock;
+}
+
+// Describes when pool releases empty pages automatically. Release starts when count of empty pages reaches
+// release threshold and stops when only spare pages are left. Gap between threshold and spare page count
+// prevents pool from allocating and freeing page every time when usage crosses page boundary. Release work is
+// spread across following Acquire and Free calls, so pages are returned gradually instead of inside one call.
+struct PageReleasePolicy
+{
+    // Empty pages are released only by explicit Shrink, ShrinkStep or Compact calls.
+    static PageReleasePolicy Never ();
+
+    // Empty pages are released as soon as there is more than sparePageCount of them.
+    static PageReleasePolicy KeepSpare (SizeType sparePageCount);
+
+    // All empty pages are released when there is emptyPageCount of them.
+    static PageReleasePolicy ReleaseAfter (SizeType emptyPageCount);
+
+    bool IsNever () const noexcept;
+
+    SizeType sparePageCount_ = 0u;
+    SizeType releaseThreshold_ = std::numeric_limits <SizeType>::max ();
+};
+
+// Target size of page in bytes, page header and malloc header included. Pools derive page capacity from it,
+// therefore pages can be sized to fill operating system pages (for example, 64 KiB or 2 MiB) without tail waste.
+struct PageSize
+{
+    std::size_t bytes_ = 0u;
+};
+
+// Describes what happens with pages, that are released from pool by shrink, compaction or page release policy.
+enum class ReleasedPageMode
+{
+    // Pages are returned to allocator.
+    FREE,
+
+    // Pages are kept by pool, but their memory except page header is returned to operating system. Address space
+    // stays the same, so kept pages are reused without allocator calls. Chunks of reused page are linked again,
+    // therefore the whole page is committed as soon as pool takes it back.
+    DECOMMIT,
+};
+
+// Frees entry of given pool. Pools with owner lookup store it in page owner headers, see PageOwner.
+using OwnedEntryFree = void (*) (void *pool, void *entry) noexcept;
+
+// Pool, that owns page, and function, that frees entries of this pool. Pools with owner lookup store owner in header
+// before every page and align page blocks, therefore entry can be freed when only its address is known.
+struct PageOwner
+{
+    void *pool_ = nullptr;
+    OwnedEntryFree free_ = nullptr;
+};
+
 struct BasePoolFields
 {
     static BasePoolFields ForEmptyPool (SizeType pageCapacity);
@@ -18,7 +84,39 @@ struct BasePoolFields
     ChunkPointer topFreeChunk_ = nullptr;
     PagePointer topPage_ = nullptr;
     SizeType pageCount_ = 0u;
+
+    // Capacity of the first page. If max page capacity is bigger, capacity of every next page is doubled.
     SizeType pageCapacity_ = 0u;
+    SizeType maxPageCapacity_ = 0u;
+
+    // State of incremental shrink, exists only while incremental shrink is in progress.
+    PoolDetail::PagePassState *shrinkStepState_ = nullptr;
+
+    // State of incremental compaction, exists only while compaction is in progress.
+    PoolDetail::PagePassState *compactState_ = nullptr;
+
+    PageReleasePolicy pageReleasePolicy_ {};
+
+    // Live chunk counts of pages, exists only if page release policy is not never and pool has pages.
+    PoolDetail::PageUsageState *pageUsageState_ = nullptr;
+
+    // Blocks, allocated by Reserve. Their pages are never freed separately.
+    PoolDetail::ReservedBlock *reservedBlocks_ = nullptr;
+
+    // Pages, that are allocated, but not used by pool: reserved pages, that are not taken yet, released pages of
+    // reserved blocks and decommitted pages. Pool uses them instead of allocating new pages.
+    PagePointer keptPages_ = nullptr;
+
+    ReleasedPageMode releasedPageMode_ = ReleasedPageMode::FREE;
+
+    // Shared depot, that receives released pages and provides pages before allocator is called. Not owned by pool.
+    PageDepot *pageDepot_ = nullptr;
+
+    // Source of ready pages, that are constructed in background. Not owned by pool.
+    PageProvisioner *pageProvisioner_ = nullptr;
+
+    // Owner, that is written to page owner headers. Owner lookup is enabled if owner pool is not null.
+    PageOwner pageOwner_ {};
 };
 
 struct UntypedPoolFields : public BasePoolFields
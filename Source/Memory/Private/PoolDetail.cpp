@@ -1,294 +1,1738 @@
-// C++ algorithms are required only for heavy-duty debug assertions.
-#ifndef NDEBUG
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include <Memory/PageDepot.hpp>
+#include <Memory/PageProvisioner.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+#include <Memory/Private/VirtualMemory.hpp>
+
+namespace Memory
+{
+namespace PoolDetail
+{
+// Incremental shrink and compaction are the same pass over pages, that differ only in page selection: shrink selects
+// pages without live entries and compaction selects the most sparse pages, whose entries fit into other pages.
+struct PagePassState
+{
+    // Selection index of pages, that are not selected.
+    static constexpr SizeType NOT_SELECTED = std::numeric_limits <SizeType>::max ();
+
+    enum class Kind
+    {
+        SHRINK,
+        COMPACT,
+    };
+
+    enum class Stage
+    {
+        // Page release in progress unlinks pages, so it is stepped until finished before pages are collected.
+        FINISH_PAGE_RELEASE,
+        // Pages are pushed one by one into heap ordered by address.
+        COLLECT_PAGES,
+        // Pages are popped one by one from heap, which leaves sorted pages behind heap.
+        SORT_PAGES,
+        // Free chunks are moved from pool free list to counted list while counting free chunks on each page.
+        COUNT_FREE_CHUNKS,
+        // Compaction pushes pages one by one into heap ordered by free chunk count.
+        ORDER_PAGES,
+        // Pages are checked one by one, compaction pops them from heap until next page does not fit.
+        SELECT_PAGES,
+        // Counted free chunks of selected pages are moved to held list, other chunks are returned to pool.
+        SEPARATE_FREE_CHUNKS,
+        // Live entries of pages, selected by compaction, are relocated to free chunks of other pages.
+        RELOCATE_ENTRIES,
+        // Selected pages are unlinked and released.
+        RELEASE_PAGES,
+    };
+
+    Kind kind_ = Kind::SHRINK;
+    Stage stage_ = Stage::FINISH_PAGE_RELEASE;
+    SizeType chunkSize_ = 0u;
+    std::vector <PagePointer> sortedPages_ {};
+    std::vector <SizeType> freeChunkCounts_ {};
+
+    PagePointer nextCollectedPage_ = nullptr;
+    SizeType pageHeapSize_ = 0u;
+
+    // Sorted page indices, ordered by sparsity, and index of next page, checked by shrink selection.
+    std::vector <SizeType> sparsityHeap_ {};
+    SizeType nextCheckedPage_ = 0u;
+
+    // Compaction selects pages while live chunks of selected pages fit into free chunks of other pages.
+    SizeType targetChunkCount_ = 0u;
+    SizeType requiredChunkCount_ = 0u;
+
+    // Selection index of every sorted page and sorted page index of every selected page.
+    std::vector <SizeType> selectionIndices_ {};
+    std::vector <SizeType> selectedPages_ {};
+
+    // Pages, selected by shrink, have no live chunks, so only compaction tracks free chunks of selected pages.
+    // Pages may have different capacities, so the biggest one is used as stride for flags.
+    SizeType flagsStride_ = 0u;
+    std::vector <bool> isSelectedChunkFree_ {};
+
+    ChunkPointer topCountedChunk_ = nullptr;
+    ChunkPointer lastCountedChunk_ = nullptr;
+
+    // Free chunks of selected pages, including chunks, that were freed by relocation.
+    ChunkPointer topHeldChunk_ = nullptr;
+    ChunkPointer lastHeldChunk_ = nullptr;
+
+    SizeType currentSelection_ = 0u;
+    SizeType currentChunkIndex_ = 0u;
+
+    PagePointer previousPage_ = nullptr;
+    PagePointer currentPage_ = nullptr;
+};
+
+struct PageUsageState
+{
+    // Live chunk count of pages, that are selected for release, is replaced with this mark.
+    static constexpr SizeType RELEASED_PAGE_MARK = std::numeric_limits <SizeType>::max ();
+
+    enum class ReleaseStage
+    {
+        IDLE,
+        // Free chunks, taken from pool free list, are checked one by one and chunks of marked pages are dropped.
+        UNLINK_CHUNKS,
+        // Marked pages are unlinked from page list and released.
+        POP_PAGES,
+    };
+
+    std::vector <PagePointer> sortedPages_ {};
+    std::vector <SizeType> liveChunkCounts_ {};
+    SizeType emptyPageCount_ = 0u;
+
+    ReleaseStage releaseStage_ = ReleaseStage::IDLE;
+    ChunkPointer topUncheckedChunk_ = nullptr;
+    PagePointer previousPage_ = nullptr;
+    PagePointer currentPage_ = nullptr;
+};
+
+// Count of free chunks or pages, that every Acquire and Free processes while page release is in progress.
+constexpr SizeType PAGE_RELEASE_STEP_BUDGET = 8u;
+
+struct ReservedBlock
+{
+    ReservedBlock *next_ = nullptr;
+    std::size_t size_ = 0u;
+};
+
+// Pages inside reserved block are aligned in the same way as pages, allocated by malloc.
+constexpr std::size_t RESERVED_BLOCK_ALIGNMENT = alignof (std::max_align_t);
+
+// Typical operating system memory page size, that is used to touch every page during prefault.
+constexpr std::size_t PREFAULT_STEP = 4096u;
+
+void PushFreeChunk (BasePoolFields &fields, ChunkPointer chunk) noexcept;
+
+ChunkPointer PopFreeChunk (BasePoolFields &fields) noexcept;
+
+void PushPage (BasePoolFields &fields, PagePointer page) noexcept;
+
+// Unlinks page from pool and either frees it or keeps it for reuse, see ReleasedPageMode.
+void PopPage (BasePoolFields &fields, SizeType chunkSize, PagePointer page, PagePointer previous,
+              PagePointer next) noexcept;
+
+// Links chunks of given empty page into free list and pushes page to pool.
+void AddEmptyPage (BasePoolFields &fields, SizeType chunkSize, PagePointer page) noexcept;
+
+PagePointer TakeKeptPage (BasePoolFields &fields, SizeType chunkSize) noexcept;
+
+// Takes kept page, ready page from provisioner, page from depot or allocates new page, in this order.
+// Chunks of returned page are linked.
+PagePointer ObtainEmptyPage (BasePoolFields &fields, SizeType chunkSize, SizeType pageCapacity) noexcept;
+
+// Deposits page, that is not kept by pool, into depot or frees it if there is no depot or depot is full.
+void FreePage (const BasePoolFields &fields, SizeType chunkSize, PagePointer page) noexcept;
+
+// Allocates aligned page block with owner of given pool in owner header. Chunks of returned page are not linked.
+PagePointer AllocateOwnedPage (const BasePoolFields &fields, SizeType chunkSize, SizeType pageCapacity) noexcept;
+
+// Does the same thing as AllocateOwnedPage, but links chunks of returned page.
+PagePointer ConstructOwnedPage (const BasePoolFields &fields, SizeType chunkSize, SizeType pageCapacity) noexcept;
+
+// Adds reserved page with capacity in header. Chunks of prefaulted page are linked and page is pushed to pool,
+// other pages are kept until pool needs them, so only their headers are written and their memory is committed lazily.
+void AddReservedPage (BasePoolFields &fields, SizeType chunkSize, PagePointer page, bool prefault) noexcept;
+
+// Frees page block of pool with owner lookup.
+void FreeOwnedPage (PagePointer page, SizeType chunkSize) noexcept;
+
+bool IsReservedPage (const BasePoolFields &fields, PagePointer page) noexcept;
+
+std::size_t AlignSize (std::size_t size, std::size_t alignment) noexcept;
+
+// Pushes chunk to the list, that is owned by incremental pass. Last chunk is tracked to make splicing O(1).
+void PushPassChunk (ChunkPointer &top, ChunkPointer &last, ChunkPointer chunk) noexcept;
+
+void SpliceToFreeList (BasePoolFields &fields, ChunkPointer &top, ChunkPointer &last) noexcept;
+
+// Cancels other pass before new pass is started. Pass, that already releases pages, can not be cancelled cheaply,
+// so its release is stepped with given budget instead. Returns false if release of other pass is not finished.
+bool FinishOtherPass (BasePoolFields &fields, PagePassState *&otherState, SizeType &budget) noexcept;
+
+// Processes no more than budget units of given pass. Returns true if pass is finished and its state is deleted.
+bool PagePassStep (BasePoolFields &fields, PagePassState *&state, SizeType &budget, RelocationCallback relocate,
+                   void *context) noexcept;
+
+// Returns all free chunks, held by given pass, back to pool and deletes pass state.
+void CancelPagePass (BasePoolFields &fields, PagePassState *&state) noexcept;
+
+// Order of compaction heap: pages with more free chunks are popped first, pages with lower address break ties.
+bool IsLessSparse (const PagePassState &state, SizeType first, SizeType second) noexcept;
+
+// Checks next page for selection. Returns false if selection is finished.
+bool SelectPassPage (PagePassState &state) noexcept;
+
+// Holds chunk, freed during compaction, if it belongs to selected page or if selection is not finished yet.
+// Returns false if chunk must be returned to pool.
+bool HoldPassChunk (PagePassState &state, ChunkPointer chunk) noexcept;
+
+// Returns free chunks of selected pages, that are not evacuated yet, to pool and deselects these pages.
+void AbandonSelectedPages (BasePoolFields &fields, PagePassState &state) noexcept;
+
+void ReleasePassPage (BasePoolFields &fields, PagePassState &state) noexcept;
+
+// Moves live chunk from source page to target page in live chunk counts.
+void RelocatePageUsage (BasePoolFields &fields, SizeType chunkSize, ChunkPointer source, ChunkPointer target) noexcept;
+
+// Both free chunks and pages store pointer to next list node in their first bytes,
+// therefore the same sorting algorithm can be used for both lists.
+void *SortAddressList (void *head) noexcept;
+
+void *MergeAddressLists (void *first, void *second) noexcept;
+
+void CollectSortedPages (BasePoolFields &fields, std::vector <PagePointer> &output) noexcept;
+
+SizeType FindSortedChunkPageIndex (const std::vector <PagePointer> &sortedPages, SizeType chunkSize,
+                                   ChunkPointer chunk) noexcept;
+
+// Capacity of new page doubles with every existing page until it reaches max page capacity.
+SizeType GetNewPageCapacity (const BasePoolFields &fields, SizeType pageCount) noexcept;
+
+// Recalculates live chunk counts from free list. Expects that there is no incremental shrink, compaction or release.
+void RebuildPageUsage (BasePoolFields &fields, SizeType chunkSize) noexcept;
+
+bool IsPageReleaseInProgress (const BasePoolFields &fields) noexcept;
+
+// Marks empty pages above spare page count for release and takes whole free list for checking.
+void StartPageRelease (BasePoolFields &fields) noexcept;
+
+// Processes no more than budget free chunks or pages of page release. Returns true if there is no release in progress.
+bool PageReleaseStep (BasePoolFields &fields, SizeType chunkSize, SizeType budget) noexcept;
+}
+
+namespace PageDetail
+{
+void SetCapacity (PagePointer page, SizeType pageCapacity) noexcept;
+
+// Links all chunks of given page into one list, that starts from first chunk and ends with last chunk.
+void InitializeEmptyPage (PagePointer page, SizeType chunkSize) noexcept;
+
+// Decommits all operating system pages, that are fully covered by chunks of given page.
+// Page header is left untouched, because kept pages list is linked through it.
+void Decommit (PagePointer page, SizeType chunkSize) noexcept;
+}
+
+namespace PoolDetail
+{
+void AssertPoolState (BasePoolFields &fields, SizeType chunkSize) noexcept
+{
+    assert (chunkSize >= sizeof (uintptr_t));
+    assert (fields.pageCapacity_ > 0u);
+    assert (fields.maxPageCapacity_ >= fields.pageCapacity_);
+    assert (!fields.topFreeChunk_ || fields.topPage_);
+
+    assert (std::count_if (
+        PageDetail::PageIterator::Begin (fields),
+        PageDetail::PageIterator::End (fields),
+        [] (PagePointer page)
+        {
+            return true;
+        }) == fields.pageCount_);
+}
+
+void AssertFromPool (BasePoolFields &fields, void *entry, SizeType chunkSize) noexcept
+{
+    assert (std::find_if (
+        PageDetail::PageIterator::Begin (fields),
+        PageDetail::PageIterator::End (fields),
+
+        [entry, &fields, chunkSize] (PagePointer page)
+        {
+            return PageDetail::IsFrom (page, chunkSize, entry);
+        }) != PageDetail::PageIterator::End (fields));
+}
+
+void *Acquire (BasePoolFields &fields, SizeType chunkSize) noexcept
+{
+    AssertPoolState (fields, chunkSize);
+    if (!fields.topFreeChunk_)
+    {
+        // Incremental shrink and compaction may hold free chunks, they must be used before constructing new page.
+        CancelShrinkStep (fields);
+        CancelCompact (fields);
+    }
+
+    if (fields.pageUsageState_)
+    {
+        // Page release returns checked free chunks gradually. Release must also be finished before adding new page,
+        // because it walks page list.
+        while (!fields.topFreeChunk_ && !PageReleaseStep (fields, chunkSize, 1u))
+        {
+        }
+    }
+
+    if (!fields.topFreeChunk_)
+    {
+        PagePointer newPage = ObtainEmptyPage (fields, chunkSize, GetNewPageCapacity (fields, fields.pageCount_));
+        AddEmptyPage (fields, chunkSize, newPage);
+        assert (fields.topFreeChunk_);
+    }
+
+    ChunkPointer chunk = PopFreeChunk (fields);
+    if (fields.pageUsageState_)
+    {
+        PageUsageState &usage = *fields.pageUsageState_;
+        SizeType &liveChunkCount = usage.liveChunkCounts_[FindSortedChunkPageIndex (
+            usage.sortedPages_, chunkSize, chunk)];
+
+        if (liveChunkCount == 0u)
+        {
+            --usage.emptyPageCount_;
+        }
+
+        ++liveChunkCount;
+        PageReleaseStep (fields, chunkSize, PAGE_RELEASE_STEP_BUDGET);
+    }
+
+    return chunk;
+}
+
+void Free (BasePoolFields &fields, void *entry, SizeType chunkSize) noexcept
+{
+    AssertPoolState (fields, chunkSize);
+    AssertFromPool (fields, entry, chunkSize);
+    if (!fields.compactState_ || !HoldPassChunk (*fields.compactState_, entry))
+    {
+        PushFreeChunk (fields, entry);
+    }
+
+    if (fields.pageUsageState_)
+    {
+        PageUsageState &usage = *fields.pageUsageState_;
+        SizeType &liveChunkCount = usage.liveChunkCounts_[FindSortedChunkPageIndex (
+            usage.sortedPages_, chunkSize, entry)];
+
+        assert (liveChunkCount > 0u);
+        if (--liveChunkCount == 0u && ++usage.emptyPageCount_ >= fields.pageReleasePolicy_.releaseThreshold_ &&
+            usage.releaseStage_ == PageUsageState::ReleaseStage::IDLE)
+        {
+            StartPageRelease (fields);
+        }
+
+        PageReleaseStep (fields, chunkSize, PAGE_RELEASE_STEP_BUDGET);
+    }
+}
+
+void Reserve (BasePoolFields &fields, SizeType chunkSize, SizeType entryCount, bool prefault) noexcept
+{
+    // Incremental operations describe existing pages only, so they must not outlive new pages.
+    CancelShrinkStep (fields);
+    CancelCompact (fields);
+    FinishPageRelease (fields, chunkSize);
+    AssertPoolState (fields, chunkSize);
+    // Pages may have different capacities, therefore capacity of every existing page is counted.
+    std::size_t capacity = 0u;
+
+    std::for_each (PageDetail::PageIterator::Begin (fields), PageDetail::PageIterator::End (fields),
+                   [&capacity] (PagePointer page)
+                   {
+                       capacity += PageDetail::GetCapacity (page);
+                   });
+
+    // Kept pages are already allocated, so they are taken only when prefault is requested, because taking page
+    // links its chunks and therefore commits it.
+    if (prefault)
+    {
+        while (capacity < entryCount && fields.keptPages_)
+        {
+            PagePointer page = TakeKeptPage (fields, chunkSize);
+            capacity += PageDetail::GetCapacity (page);
+            AddEmptyPage (fields, chunkSize, page);
+        }
+    }
+    else
+    {
+        for (PagePointer page = fields.keptPages_; page && capacity < entryCount; page = PageDetail::NextPage (page))
+        {
+            capacity += PageDetail::GetCapacity (page);
+        }
+    }
+
+    // Pages, that are not prefaulted, are not counted by pool until it takes them, so growth is tracked separately.
+    const SizeType pageCountBefore = fields.pageCount_;
+    SizeType newPageCount = 0u;
+
+    // Pages of pools with owner lookup must be aligned separately, therefore they can not share one block.
+    while (capacity < entryCount && fields.pageOwner_.pool_)
+    {
+        PagePointer page =
+            AllocateOwnedPage (fields, chunkSize, GetNewPageCapacity (fields, pageCountBefore + newPageCount));
+        capacity += PageDetail::GetCapacity (page);
+        AddReservedPage (fields, chunkSize, page, prefault);
+        ++newPageCount;
+    }
+
+    if (capacity >= entryCount)
+    {
+        return;
+    }
+
+    const std::size_t headerSize = AlignSize (sizeof (ReservedBlock), RESERVED_BLOCK_ALIGNMENT);
+    std::size_t blockSize = headerSize;
+    const SizeType blockFirstPageIndex = pageCountBefore + newPageCount;
+    newPageCount = 0u;
+
+    while (capacity < entryCount)
+    {
+        const SizeType pageCapacity = GetNewPageCapacity (fields, blockFirstPageIndex + newPageCount);
+        capacity += pageCapacity;
+        blockSize += AlignSize (PageDetail::GetPageSize (pageCapacity, chunkSize), RESERVED_BLOCK_ALIGNMENT);
+        ++newPageCount;
+    }
+
+    // TODO: Handle malloc errors?
+    void *memory = malloc (blockSize);
+    assert (memory);
+
+    if (prefault)
+    {
+        // Writes are volatile, otherwise compiler is allowed to merge malloc and writes into calloc call.
+        auto *bytes = static_cast <volatile uint8_t *> (memory);
+        for (std::size_t offset = 0u; offset < blockSize; offset += PREFAULT_STEP)
+        {
+            bytes[offset] = 0u;
+        }
+    }
+
+    fields.reservedBlocks_ = new (memory) ReservedBlock {fields.reservedBlocks_, blockSize};
+    auto *page = static_cast <uint8_t *> (memory) + headerSize;
+
+    for (SizeType pageIndex = 0u; pageIndex < newPageCount; ++pageIndex)
+    {
+        // Capacities are the same as during block size calculation.
+        const SizeType pageCapacity = GetNewPageCapacity (fields, blockFirstPageIndex + pageIndex);
+        PageDetail::SetCapacity (page, pageCapacity);
+        AddReservedPage (fields, chunkSize, page, prefault);
+        page += AlignSize (PageDetail::GetPageSize (pageCapacity, chunkSize), RESERVED_BLOCK_ALIGNMENT);
+    }
+}
+
+void SetReleasedPageMode (BasePoolFields &fields, ReleasedPageMode mode) noexcept
+{
+    // Pages, that are already kept, stay kept until they are reused or pool is cleaned.
+    fields.releasedPageMode_ = mode;
+}
+
+void SetMaxPageCapacity (BasePoolFields &fields, SizeType chunkSize, SizeType maxPageCapacity) noexcept
+{
+    assert (maxPageCapacity >= fields.pageCapacity_);
+    fields.maxPageCapacity_ = fields.pageOwner_.pool_ ?
+                              std::min (maxPageCapacity, PageDetail::GetMaxOwnedPageCapacity (chunkSize)) :
+                              maxPageCapacity;
+}
+
+void SetPageDepot (BasePoolFields &fields, PageDepot *depot) noexcept
+{
+    fields.pageDepot_ = depot;
+}
+
+void SetPageProvisioner (BasePoolFields &fields, [[maybe_unused]] SizeType chunkSize,
+                         PageProvisioner *provisioner) noexcept
+{
+    assert (!provisioner || provisioner->GetChunkSize () == chunkSize);
+    fields.pageProvisioner_ = provisioner;
+}
+
+bool SetPageOwner (BasePoolFields &fields, SizeType chunkSize, const PageOwner &owner) noexcept
+{
+    assert (owner.pool_);
+    assert (owner.free_);
+
+    if (!fields.pageOwner_.pool_)
+    {
+        // Existing pages are not aligned, therefore owner lookup can only be enabled for empty pool.
+        assert (fields.pageCount_ == 0u);
+        assert (!fields.keptPages_);
+        assert (!fields.reservedBlocks_);
+
+        const SizeType maxOwnedPageCapacity = PageDetail::GetMaxOwnedPageCapacity (chunkSize);
+        if (maxOwnedPageCapacity == 0u)
+        {
+            return false;
+        }
+
+        // Page size is usually selected for allocator, so it is clamped instead of rejecting owner lookup.
+        fields.pageCapacity_ = std::min (fields.pageCapacity_, maxOwnedPageCapacity);
+        fields.maxPageCapacity_ = std::min (fields.maxPageCapacity_, maxOwnedPageCapacity);
+    }
+
+    fields.pageOwner_ = owner;
+    std::for_each (PageDetail::PageIterator::Begin (fields), PageDetail::PageIterator::End (fields),
+                   [&owner] (PagePointer page)
+                   {
+                       PageDetail::SetOwner (page, owner);
+                   });
+
+    for (PagePointer page = fields.keptPages_; page; page = PageDetail::NextPage (page))
+    {
+        PageDetail::SetOwner (page, owner);
+    }
+
+    return true;
+}
+
+void FreeOwnedEntry (void *entry) noexcept
+{
+    assert (entry);
+    const PageOwner owner = PageDetail::GetOwner (PageDetail::GetOwnedChunkPage (entry));
+    assert (owner.pool_);
+    assert (owner.free_);
+    owner.free_ (owner.pool_, entry);
+}
+
+void TrivialClean (BasePoolFields &fields, SizeType chunkSize) noexcept
+{
+    AssertPoolState (fields, chunkSize);
+    PageDetail::PageIterator iterator = PageDetail::PageIterator::Begin (fields);
+    PageDetail::PageIterator end = PageDetail::PageIterator::End (fields);
+
+    while (iterator != end)
+    {
+        PagePointer page = *iterator;
+        ++iterator;
+
+        if (!IsReservedPage (fields, page))
+        {
+            FreePage (fields, chunkSize, page);
+        }
+    }
+
+    while (fields.keptPages_)
+    {
+        PagePointer page = fields.keptPages_;
+        fields.keptPages_ = PageDetail::NextPage (page);
+
+        if (!IsReservedPage (fields, page))
+        {
+            FreePage (fields, chunkSize, page);
+        }
+    }
+
+    while (fields.reservedBlocks_)
+    {
+        ReservedBlock *block = fields.reservedBlocks_;
+        fields.reservedBlocks_ = block->next_;
+        free (block);
+    }
+
+    // There is no need to return chunks, held by incremental shrink or compaction, because all pages are freed.
+    delete fields.shrinkStepState_;
+    fields.shrinkStepState_ = nullptr;
+
+    delete fields.compactState_;
+    fields.compactState_ = nullptr;
+
+    // Page release policy is kept, usage state will be created again when pool constructs new page.
+    delete fields.pageUsageState_;
+    fields.pageUsageState_ = nullptr;
+
+    fields.topFreeChunk_ = nullptr;
+    fields.topPage_ = nullptr;
+    fields.pageCount_ = 0u;
+}
+
+void Shrink (BasePoolFields &fields, SizeType chunkSize) noexcept
+{
+    CancelShrinkStep (fields);
+    CancelCompact (fields);
+    FinishPageRelease (fields, chunkSize);
+    AssertPoolState (fields, chunkSize);
+    // After sorting by address free chunks of each page form continuous sequence in free list,
+    // therefore empty pages and their free chunks can be erased in one pass.
+    SortFreeChunks (fields);
+    SortPages (fields);
+
+    ChunkPointer previousFreeChunk = nullptr;
+    ChunkPointer freeChunk = fields.topFreeChunk_;
+
+    PagePointer previousPage = nullptr;
+    PageDetail::PageIterator pageIterator = PageDetail::PageIterator::Begin (fields);
+    const PageDetail::PageIterator pagesEnd = PageDetail::PageIterator::End (fields);
+
+    while (pageIterator != pagesEnd)
+    {
+        PagePointer currentPage = *pageIterator;
+        ++pageIterator;
+
+        SizeType freeChunkCount = 0u;
+        ChunkPointer lastPageFreeChunk = nullptr;
+
+        while (freeChunk && PageDetail::IsFrom (currentPage, chunkSize, freeChunk))
+        {
+            ++freeChunkCount;
+            lastPageFreeChunk = freeChunk;
+            freeChunk = NextFreeChunk (freeChunk);
+        }
+
+        assert (freeChunkCount <= PageDetail::GetCapacity (currentPage));
+        if (freeChunkCount == PageDetail::GetCapacity (currentPage))
+        {
+            if (previousFreeChunk)
+            {
+                SetNextFreeChunk (previousFreeChunk, freeChunk);
+            }
+            else
+            {
+                fields.topFreeChunk_ = freeChunk;
+            }
+
+            PopPage (fields, chunkSize, currentPage, previousPage, *pageIterator);
+        }
+        else
+        {
+            if (lastPageFreeChunk)
+            {
+                previousFreeChunk = lastPageFreeChunk;
+            }
+
+            previousPage = currentPage;
+        }
+    }
+
+    assert (!freeChunk);
+}
+
+bool ShrinkStep (BasePoolFields &fields, SizeType chunkSize, SizeType budget) noexcept
+{
+    AssertPoolState (fields, chunkSize);
+    if (!fields.shrinkStepState_)
+    {
+        if (!FinishOtherPass (fields, fields.compactState_, budget))
+        {
+            return false;
+        }
+
+        // Free list is empty during page release, because release takes whole list for checking.
+        if (!fields.topFreeChunk_ && !IsPageReleaseInProgress (fields))
+        {
+            return true;
+        }
+
+        fields.shrinkStepState_ = new PagePassState ();
+        fields.shrinkStepState_->kind_ = PagePassState::Kind::SHRINK;
+        fields.shrinkStepState_->chunkSize_ = chunkSize;
+    }
+
+    return PagePassStep (fields, fields.shrinkStepState_, budget, nullptr, nullptr);
+}
+
+void CancelShrinkStep (BasePoolFields &fields) noexcept
+{
+    CancelPagePass (fields, fields.shrinkStepState_);
+}
+
+bool Compact (BasePoolFields &fields, SizeType chunkSize, SizeType budget,
+              RelocationCallback relocate, void *context) noexcept
+{
+    AssertPoolState (fields, chunkSize);
+    assert (relocate);
+
+    if (!fields.compactState_)
+    {
+        if (!FinishOtherPass (fields, fields.shrinkStepState_, budget))
+        {
+            return false;
+        }
+
+        // Compaction needs at least one source and one target page.
+        if ((!fields.topFreeChunk_ && !IsPageReleaseInProgress (fields)) || fields.pageCount_ < 2u)
+        {
+            return true;
+        }
+
+        fields.compactState_ = new PagePassState ();
+        fields.compactState_->kind_ = PagePassState::Kind::COMPACT;
+        fields.compactState_->chunkSize_ = chunkSize;
+    }
+
+    return PagePassStep (fields, fields.compactState_, budget, relocate, context);
+}
+
+void CancelCompact (BasePoolFields &fields) noexcept
+{
+    CancelPagePass (fields, fields.compactState_);
+}
+
+void SetPageReleasePolicy (BasePoolFields &fields, SizeType chunkSize, const PageReleasePolicy &policy) noexcept
+{
+    // Live chunk counts are calculated from free list, so chunks held by incremental operations must be returned.
+    CancelShrinkStep (fields);
+    CancelCompact (fields);
+    FinishPageRelease (fields, chunkSize);
+    AssertPoolState (fields, chunkSize);
+    fields.pageReleasePolicy_ = policy;
+
+    if (policy.IsNever ())
+    {
+        delete fields.pageUsageState_;
+        fields.pageUsageState_ = nullptr;
+        return;
+    }
+
+    assert (policy.releaseThreshold_ > policy.sparePageCount_);
+    if (fields.pageCount_ == 0u)
+    {
+        return;
+    }
+
+    if (!fields.pageUsageState_)
+    {
+        fields.pageUsageState_ = new PageUsageState ();
+    }
+
+    RebuildPageUsage (fields, chunkSize);
+    if (fields.pageUsageState_->emptyPageCount_ >= policy.releaseThreshold_)
+    {
+        // Policy change is already expensive, so there is no need to amortize this release.
+        StartPageRelease (fields);
+        FinishPageRelease (fields, chunkSize);
+    }
+}
+
+void FinishPageRelease (BasePoolFields &fields, SizeType chunkSize) noexcept
+{
+    if (fields.pageUsageState_)
+    {
+        while (!PageReleaseStep (fields, chunkSize, std::numeric_limits <SizeType>::max ()))
+        {
+        }
+    }
+}
+
+ChunkPointer DetachFreeChunks (BasePoolFields &fields, SizeType chunkSize, SizeType maxCount,
+                               SizeType &detachedCount) noexcept
+{
+    assert (!fields.pageUsageState_);
+    assert (maxCount > 0u);
+    // Acquire already knows how to obtain new page, so acquired chunk is just linked back to the list.
+    ChunkPointer top = Acquire (fields, chunkSize);
+    SetNextFreeChunk (top, fields.topFreeChunk_);
+
+    ChunkPointer last = top;
+    detachedCount = 1u;
+
+    while (detachedCount < maxCount && NextFreeChunk (last))
+    {
+        last = NextFreeChunk (last);
+        ++detachedCount;
+    }
+
+    fields.topFreeChunk_ = NextFreeChunk (last);
+    SetNextFreeChunk (last, nullptr);
+    return top;
+}
+
+void AttachFreeChunks (BasePoolFields &fields, ChunkPointer top, ChunkPointer last) noexcept
+{
+    assert (top && last);
+    SetNextFreeChunk (last, fields.topFreeChunk_);
+    fields.topFreeChunk_ = top;
+}
+
+void SortFreeChunks (BasePoolFields &fields) noexcept
+{
+    fields.topFreeChunk_ = SortAddressList (fields.topFreeChunk_);
+}
+
+ChunkPointer SortFreeChunks (ChunkPointer topFreeChunk) noexcept
+{
+    return SortAddressList (topFreeChunk);
+}
+
+void SortPages (BasePoolFields &fields) noexcept
+{
+    fields.topPage_ = SortAddressList (fields.topPage_);
+}
+
+void PushFreeChunk (BasePoolFields &fields, ChunkPointer chunk) noexcept
+{
+    SetNextFreeChunk (chunk, fields.topFreeChunk_);
+    fields.topFreeChunk_ = chunk;
+}
+
+ChunkPointer PopFreeChunk (BasePoolFields &fields) noexcept
+{
+    assert (fields.topFreeChunk_);
+    ChunkPointer current = fields.topFreeChunk_;
+    fields.topFreeChunk_ = NextFreeChunk (current);
+    return current;
+}
+
+void PushPage (BasePoolFields &fields, PagePointer page) noexcept
+{
+    if (!fields.pageReleasePolicy_.IsNever ())
+    {
+        if (!fields.pageUsageState_)
+        {
+            assert (fields.pageCount_ == 0u);
+            fields.pageUsageState_ = new PageUsageState ();
+        }
+
+        PageUsageState &usage = *fields.pageUsageState_;
+        const auto iterator = std::lower_bound (usage.sortedPages_.begin (), usage.sortedPages_.end (), page);
+
+        usage.liveChunkCounts_.insert (usage.liveChunkCounts_.begin () + (iterator - usage.sortedPages_.begin ()), 0u);
+        usage.sortedPages_.insert (iterator, page);
+        ++usage.emptyPageCount_;
+    }
+
+    PageDetail::SetNextPage (page, fields.topPage_);
+    fields.topPage_ = page;
+    ++fields.pageCount_;
+}
+
+void PopPage (BasePoolFields &fields, SizeType chunkSize, PagePointer page, PagePointer previous,
+              PagePointer next) noexcept
+{
+    assert (fields.pageCount_);
+    assert (page);
+    assert (PageDetail::NextPage (page) == next);
+    assert (!previous || PageDetail::NextPage (previous) == page);
+
+    if (fields.pageUsageState_)
+    {
+        PageUsageState &usage = *fields.pageUsageState_;
+        const auto iterator = std::lower_bound (usage.sortedPages_.begin (), usage.sortedPages_.end (), page);
+        assert (iterator != usage.sortedPages_.end () && *iterator == page);
+
+        const auto countIterator = usage.liveChunkCounts_.begin () + (iterator - usage.sortedPages_.begin ());
+        if (*countIterator == 0u || *countIterator == PageUsageState::RELEASED_PAGE_MARK)
+        {
+            --usage.emptyPageCount_;
+        }
+
+        usage.liveChunkCounts_.erase (countIterator);
+        usage.sortedPages_.erase (iterator);
+    }
+
+    --fields.pageCount_;
+    if (previous)
+    {
+        PageDetail::SetNextPage (previous, next);
+    }
+    else
+    {
+        fields.topPage_ = next;
+    }
+
+    // Depot is preferred over decommit, because other pool may need page soon and commit is not free.
+    const bool reserved = IsReservedPage (fields, page);
+    if (!reserved && !fields.pageOwner_.pool_ && fields.pageDepot_ &&
+        fields.pageDepot_->Deposit (page, PageDetail::GetPageSize (PageDetail::GetCapacity (page), chunkSize)))
+    {
+        return;
+    }
+
+    if (fields.releasedPageMode_ == ReleasedPageMode::DECOMMIT)
+    {
+        PageDetail::Decommit (page, chunkSize);
+    }
+
+    if (fields.releasedPageMode_ == ReleasedPageMode::DECOMMIT || reserved)
+    {
+        PageDetail::SetNextPage (page, fields.keptPages_);
+        fields.keptPages_ = page;
+    }
+    else if (fields.pageOwner_.pool_)
+    {
+        FreeOwnedPage (page, chunkSize);
+    }
+    else
+    {
+        free (page);
+    }
+}
+
+void AddEmptyPage (BasePoolFields &fields, SizeType chunkSize, PagePointer page) noexcept
+{
+    ChunkPointer first = PageDetail::GetFirstChunk (page);
+    ChunkPointer last = PageDetail::GetLastChunk (page, chunkSize);
+
+    SetNextFreeChunk (last, fields.topFreeChunk_);
+    fields.topFreeChunk_ = first;
+    PushPage (fields, page);
+}
+
+PagePointer TakeKeptPage (BasePoolFields &fields, SizeType chunkSize) noexcept
+{
+    assert (fields.keptPages_);
+    PagePointer page = fields.keptPages_;
+    fields.keptPages_ = PageDetail::NextPage (page);
+
+    // Chunks of released page were linked into pool free list, therefore their links must be restored.
+    PageDetail::InitializeEmptyPage (page, chunkSize);
+    return page;
+}
+
+PagePointer ObtainEmptyPage (BasePoolFields &fields, SizeType chunkSize, SizeType pageCapacity) noexcept
+{
+    if (fields.keptPages_)
+    {
+        return TakeKeptPage (fields, chunkSize);
+    }
+
+    if (fields.pageOwner_.pool_)
+    {
+        return ConstructOwnedPage (fields, chunkSize, pageCapacity);
+    }
+
+    if (fields.pageProvisioner_)
+    {
+        if (PagePointer page = fields.pageProvisioner_->Take (pageCapacity))
+        {
+            return page;
+        }
+    }
+
+    if (fields.pageDepot_)
+    {
+        if (PagePointer page = fields.pageDepot_->Withdraw (PageDetail::GetPageSize (pageCapacity, chunkSize)))
+        {
+            // Page may be deposited by pool with other chunk size, but the same page size.
+            PageDetail::SetCapacity (page, pageCapacity);
+            PageDetail::InitializeEmptyPage (page, chunkSize);
+            return page;
+        }
+    }
+
+    return PageDetail::ConstructEmptyPage (pageCapacity, chunkSize);
+}
+
+void FreePage (const BasePoolFields &fields, SizeType chunkSize, PagePointer page) noexcept
+{
+    if (fields.pageOwner_.pool_)
+    {
+        FreeOwnedPage (page, chunkSize);
+    }
+    else if (!fields.pageDepot_ ||
+             !fields.pageDepot_->Deposit (page, PageDetail::GetPageSize (PageDetail::GetCapacity (page), chunkSize)))
+    {
+        free (page);
+    }
+}
+
+PagePointer AllocateOwnedPage (const BasePoolFields &fields, SizeType chunkSize, SizeType pageCapacity) noexcept
+{
+    assert (pageCapacity <= PageDetail::GetMaxOwnedPageCapacity (chunkSize));
+    const std::size_t blockSize = PageDetail::OWNER_HEADER_SIZE + PageDetail::GetPageSize (pageCapacity, chunkSize);
+
+    // Blocks are mapped directly, so alignment padding is neither wasted in allocator heap nor committed.
+    // TODO: Handle allocation errors?
+    void *block = VirtualMemory::AllocateAlignedPages (blockSize, PageDetail::OWNED_PAGE_ALIGNMENT);
+    assert (block);
+
+    PagePointer page = static_cast <uint8_t *> (block) + PageDetail::OWNER_HEADER_SIZE;
+    PageDetail::SetNextPage (page, nullptr);
+    PageDetail::SetCapacity (page, pageCapacity);
+    PageDetail::SetOwner (page, fields.pageOwner_);
+    return page;
+}
+
+PagePointer ConstructOwnedPage (const BasePoolFields &fields, SizeType chunkSize, SizeType pageCapacity) noexcept
+{
+    PagePointer page = AllocateOwnedPage (fields, chunkSize, pageCapacity);
+    PageDetail::InitializeEmptyPage (page, chunkSize);
+    return page;
+}
+
+void AddReservedPage (BasePoolFields &fields, SizeType chunkSize, PagePointer page, bool prefault) noexcept
+{
+    if (prefault)
+    {
+        PageDetail::InitializeEmptyPage (page, chunkSize);
+        AddEmptyPage (fields, chunkSize, page);
+    }
+    else
+    {
+        PageDetail::SetNextPage (page, fields.keptPages_);
+        fields.keptPages_ = page;
+    }
+}
+
+void FreeOwnedPage (PagePointer page, SizeType chunkSize) noexcept
+{
+    VirtualMemory::FreeAlignedPages (
+        static_cast <uint8_t *> (page) - PageDetail::OWNER_HEADER_SIZE,
+        PageDetail::OWNER_HEADER_SIZE + PageDetail::GetPageSize (PageDetail::GetCapacity (page), chunkSize));
+}
+
+bool IsReservedPage (const BasePoolFields &fields, PagePointer page) noexcept
+{
+    for (const ReservedBlock *block = fields.reservedBlocks_; block; block = block->next_)
+    {
+        const auto *blockBegin = reinterpret_cast <const uint8_t *> (block);
+        if (page > blockBegin && page < blockBegin + block->size_)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::size_t AlignSize (std::size_t size, std::size_t alignment) noexcept
+{
+    return (size + alignment - 1u) / alignment * alignment;
+}
+
+void *SortAddressList (void *head) noexcept
+{
+    // Bottom-up merge sort: bin with index i contains either nullptr or sorted list of 2^i nodes.
+    // 64 bins are enough for any list, that fits into address space, so no allocations are required.
+    constexpr std::size_t BIN_COUNT = 64u;
+    void *bins[BIN_COUNT] {};
+
+    while (head)
+    {
+        void *sorted = head;
+        head = reinterpret_cast <void *> (*static_cast <uintptr_t *> (head));
+        *static_cast <uintptr_t *> (sorted) = 0u;
+
+        std::size_t binIndex = 0u;
+        while (binIndex + 1u < BIN_COUNT && bins[binIndex])
+        {
+            sorted = MergeAddressLists (bins[binIndex], sorted);
+            bins[binIndex] = nullptr;
+            ++binIndex;
+        }
+
+        bins[binIndex] = MergeAddressLists (bins[binIndex], sorted);
+    }
+
+    void *result = nullptr;
+    for (void *bin : bins)
+    {
+        result = MergeAddressLists (bin, result);
+    }
+
+    return result;
+}
+
+void *MergeAddressLists (void *first, void *second) noexcept
+{
+    uintptr_t head = 0u;
+    uintptr_t *tailNext = &head;
+
+    while (first && second)
+    {
+        void *&lesser = first < second ? first : second;
+        *tailNext = reinterpret_cast <uintptr_t> (lesser);
+        tailNext = static_cast <uintptr_t *> (lesser);
+        lesser = reinterpret_cast <void *> (*tailNext);
+    }
+
+    *tailNext = reinterpret_cast <uintptr_t> (first ? first : second);
+    return reinterpret_cast <void *> (head);
+}
+
+void PushPassChunk (ChunkPointer &top, ChunkPointer &last, ChunkPointer chunk) noexcept
+{
+    SetNextFreeChunk (chunk, top);
+    if (!top)
+    {
+        last = chunk;
+    }
+
+    top = chunk;
+}
+
+void SpliceToFreeList (BasePoolFields &fields, ChunkPointer &top, ChunkPointer &last) noexcept
+{
+    if (top)
+    {
+        assert (last);
+        SetNextFreeChunk (last, fields.topFreeChunk_);
+        fields.topFreeChunk_ = top;
+
+        top = nullptr;
+        last = nullptr;
+    }
+}
+
+bool FinishOtherPass (BasePoolFields &fields, PagePassState *&otherState, SizeType &budget) noexcept
+{
+    if (otherState && otherState->stage_ == PagePassState::Stage::RELEASE_PAGES)
+    {
+        return PagePassStep (fields, otherState, budget, nullptr, nullptr);
+    }
+
+    CancelPagePass (fields, otherState);
+    return true;
+}
+
+bool PagePassStep (BasePoolFields &fields, PagePassState *&statePointer, SizeType &budget,
+                   RelocationCallback relocate, void *context) noexcept
+{
+    assert (statePointer);
+    PagePassState &state = *statePointer;
+    const SizeType chunkSize = state.chunkSize_;
+
+    while (budget > 0u)
+    {
+        switch (state.stage_)
+        {
+            case PagePassState::Stage::FINISH_PAGE_RELEASE:
+            {
+                if (IsPageReleaseInProgress (fields))
+                {
+                    PageReleaseStep (fields, chunkSize, 1u);
+                    --budget;
+                    break;
+                }
+
+                // Page list is stable until pass is cancelled, so pages can be collected across calls.
+                state.sortedPages_.reserve (fields.pageCount_);
+                state.freeChunkCounts_.reserve (fields.pageCount_);
+                state.selectionIndices_.reserve (fields.pageCount_);
+                state.nextCollectedPage_ = fields.topPage_;
+                state.stage_ = PagePassState::Stage::COLLECT_PAGES;
+                break;
+            }
+
+            case PagePassState::Stage::COLLECT_PAGES:
+            {
+                if (!state.nextCollectedPage_)
+                {
+                    state.pageHeapSize_ = static_cast <SizeType> (state.sortedPages_.size ());
+                    state.stage_ = PagePassState::Stage::SORT_PAGES;
+                    break;
+                }
+
+                // Counts and selection indices are the same for all pages, so their order does not depend on page order.
+                PagePointer page = state.nextCollectedPage_;
+                state.sortedPages_.push_back (page);
+                std::push_heap (state.sortedPages_.begin (), state.sortedPages_.end ());
+                state.freeChunkCounts_.push_back (0u);
+                state.selectionIndices_.push_back (PagePassState::NOT_SELECTED);
+                state.flagsStride_ = std::max (state.flagsStride_, PageDetail::GetCapacity (page));
+
+                state.nextCollectedPage_ = PageDetail::NextPage (page);
+                --budget;
+                break;
+            }
+
+            case PagePassState::Stage::SORT_PAGES:
+            {
+                if (state.pageHeapSize_ == 0u)
+                {
+                    state.stage_ = PagePassState::Stage::COUNT_FREE_CHUNKS;
+                    break;
+                }
+
+                std::pop_heap (state.sortedPages_.begin (), state.sortedPages_.begin () + state.pageHeapSize_);
+                --state.pageHeapSize_;
+                --budget;
+                break;
+            }
+
+            case PagePassState::Stage::COUNT_FREE_CHUNKS:
+            {
+                // Chunks, freed during this stage, are pushed to pool free list and will be counted too.
+                if (!fields.topFreeChunk_)
+                {
+                    state.stage_ = PagePassState::Stage::ORDER_PAGES;
+                    break;
+                }
+
+                ChunkPointer chunk = PopFreeChunk (fields);
+                ++state.freeChunkCounts_[FindSortedChunkPageIndex (state.sortedPages_, chunkSize, chunk)];
+                ++state.targetChunkCount_;
+
+                PushPassChunk (state.topCountedChunk_, state.lastCountedChunk_, chunk);
+                --budget;
+                break;
+            }
+
+            case PagePassState::Stage::ORDER_PAGES:
+            {
+                // Pages without live chunks are selected independently, so only compaction orders pages.
+                if (state.kind_ == PagePassState::Kind::SHRINK ||
+                    state.sparsityHeap_.size () == state.sortedPages_.size ())
+                {
+                    state.stage_ = PagePassState::Stage::SELECT_PAGES;
+                    break;
+                }
+
+                state.sparsityHeap_.push_back (static_cast <SizeType> (state.sparsityHeap_.size ()));
+                std::push_heap (state.sparsityHeap_.begin (), state.sparsityHeap_.end (),
+                                [&state] (SizeType first, SizeType second)
+                                {
+                                    return IsLessSparse (state, first, second);
+                                });
+
+                --budget;
+                break;
+            }
+
+            case PagePassState::Stage::SELECT_PAGES:
+            {
+                if (SelectPassPage (state))
+                {
+                    --budget;
+                    break;
+                }
+
+                if (state.selectedPages_.empty ())
+                {
+                    CancelPagePass (fields, statePointer);
+                    return true;
+                }
+
+                state.sparsityHeap_.clear ();
+                state.stage_ = PagePassState::Stage::SEPARATE_FREE_CHUNKS;
+                break;
+            }
+
+            case PagePassState::Stage::SEPARATE_FREE_CHUNKS:
+            {
+                if (!state.topCountedChunk_)
+                {
+                    state.stage_ = PagePassState::Stage::RELOCATE_ENTRIES;
+                    break;
+                }
+
+                ChunkPointer chunk = state.topCountedChunk_;
+                state.topCountedChunk_ = NextFreeChunk (chunk);
+
+                if (!state.topCountedChunk_)
+                {
+                    state.lastCountedChunk_ = nullptr;
+                }
+
+                if (!HoldPassChunk (state, chunk))
+                {
+                    PushFreeChunk (fields, chunk);
+                }
+
+                --budget;
+                break;
+            }
+
+            case PagePassState::Stage::RELOCATE_ENTRIES:
+            {
+                if (state.kind_ == PagePassState::Kind::SHRINK || state.currentSelection_ == state.selectedPages_.size ())
+                {
+                    // Held list contains only chunks of selected pages, that will be released, so it can be dropped.
+                    state.topHeldChunk_ = nullptr;
+                    state.lastHeldChunk_ = nullptr;
+
+                    state.stage_ = PagePassState::Stage::RELEASE_PAGES;
+                    state.previousPage_ = nullptr;
+                    state.currentPage_ = fields.topPage_;
+                    break;
+                }
+
+                PagePointer page = state.sortedPages_[state.selectedPages_[state.currentSelection_]];
+                if (state.currentChunkIndex_ == PageDetail::GetCapacity (page))
+                {
+                    ++state.currentSelection_;
+                    state.currentChunkIndex_ = 0u;
+                    break;
+                }
 
-#include <algorithm>
+                const SizeType flagIndex = state.currentSelection_ * state.flagsStride_ + state.currentChunkIndex_;
+                if (!state.isSelectedChunkFree_[flagIndex])
+                {
+                    // Targets could be taken by Acquire after pages were selected.
+                    if (!fields.topFreeChunk_)
+                    {
+                        AbandonSelectedPages (fields, state);
+                        break;
+                    }
+
+                    ChunkPointer source = static_cast <uint8_t *> (PageDetail::GetFirstChunk (page)) +
+                                          static_cast <std::size_t> (state.currentChunkIndex_) * chunkSize;
+                    ChunkPointer target = PopFreeChunk (fields);
+
+                    assert (relocate);
+                    relocate (context, source, target);
+                    RelocatePageUsage (fields, chunkSize, source, target);
+                    state.isSelectedChunkFree_[flagIndex] = true;
+                    PushPassChunk (state.topHeldChunk_, state.lastHeldChunk_, source);
+                }
 
-#endif
+                ++state.currentChunkIndex_;
+                --budget;
+                break;
+            }
 
-#include <cassert>
-#include <cstdlib>
-#include <vector>
+            case PagePassState::Stage::RELEASE_PAGES:
+            {
+                if (!state.currentPage_)
+                {
+                    delete statePointer;
+                    statePointer = nullptr;
+                    return true;
+                }
 
-#include <Memory/Private/PoolDetail.hpp>
+                ReleasePassPage (fields, state);
+                --budget;
+                break;
+            }
+        }
+    }
 
-namespace Memory
+    return false;
+}
+
+void CancelPagePass (BasePoolFields &fields, PagePassState *&state) noexcept
 {
-namespace PoolDetail
+    if (!state)
+    {
+        return;
+    }
+
+    if (state->stage_ == PagePassState::Stage::RELEASE_PAGES)
+    {
+        // Free chunks of selected pages are already dropped, therefore the only way to cancel is to finish.
+        while (state->currentPage_)
+        {
+            ReleasePassPage (fields, *state);
+        }
+    }
+    else
+    {
+        SpliceToFreeList (fields, state->topCountedChunk_, state->lastCountedChunk_);
+        SpliceToFreeList (fields, state->topHeldChunk_, state->lastHeldChunk_);
+    }
+
+    delete state;
+    state = nullptr;
+}
+
+bool IsLessSparse (const PagePassState &state, SizeType first, SizeType second) noexcept
+{
+    return state.freeChunkCounts_[first] < state.freeChunkCounts_[second] ||
+           (state.freeChunkCounts_[first] == state.freeChunkCounts_[second] && first > second);
+}
+
+bool SelectPassPage (PagePassState &state) noexcept
 {
-void SetNextFreeChunk (ChunkPointer chunk, ChunkPointer next) noexcept;
+    SizeType pageIndex;
+    if (state.kind_ == PagePassState::Kind::SHRINK)
+    {
+        if (state.nextCheckedPage_ == state.sortedPages_.size ())
+        {
+            return false;
+        }
 
-void PushFreeChunk (BasePoolFields &fields, ChunkPointer chunk) noexcept;
+        pageIndex = state.nextCheckedPage_++;
+        if (state.freeChunkCounts_[pageIndex] != PageDetail::GetCapacity (state.sortedPages_[pageIndex]))
+        {
+            return true;
+        }
+    }
+    else
+    {
+        if (state.sparsityHeap_.empty ())
+        {
+            return false;
+        }
 
-ChunkPointer PopFreeChunk (BasePoolFields &fields) noexcept;
+        pageIndex = state.sparsityHeap_.front ();
+        const SizeType freeCount = state.freeChunkCounts_[pageIndex];
+        const SizeType liveCount = PageDetail::GetCapacity (state.sortedPages_[pageIndex]) - freeCount;
 
-void PushPage (BasePoolFields &fields, PagePointer page) noexcept;
+        if (state.requiredChunkCount_ + liveCount > state.targetChunkCount_ - freeCount)
+        {
+            return false;
+        }
+
+        std::pop_heap (state.sparsityHeap_.begin (), state.sparsityHeap_.end (),
+                       [&state] (SizeType first, SizeType second)
+                       {
+                           return IsLessSparse (state, first, second);
+                       });
+
+        state.sparsityHeap_.pop_back ();
+        state.targetChunkCount_ -= freeCount;
+        state.requiredChunkCount_ += liveCount;
+        state.isSelectedChunkFree_.resize (state.isSelectedChunkFree_.size () + state.flagsStride_, false);
+    }
 
-void PopPage (BasePoolFields &fields, PagePointer page, PagePointer previous, PagePointer next) noexcept;
+    state.selectionIndices_[pageIndex] = static_cast <SizeType> (state.selectedPages_.size ());
+    state.selectedPages_.push_back (pageIndex);
+    return true;
 }
 
-namespace PageDetail
+bool HoldPassChunk (PagePassState &state, ChunkPointer chunk) noexcept
 {
-PagePointer ConstructEmptyPage (SizeType pageCapacity, SizeType chunkSize) noexcept;
+    if (state.stage_ == PagePassState::Stage::ORDER_PAGES || state.stage_ == PagePassState::Stage::SELECT_PAGES)
+    {
+        // Counts are already used for selection, so chunk is separated later without being counted.
+        // Selection only underestimates free chunks then, which can not make it wrong.
+        PushPassChunk (state.topCountedChunk_, state.lastCountedChunk_, chunk);
+        return true;
+    }
+
+    // Selected pages are known only after selection and released pages can not have freed chunks.
+    if (state.stage_ != PagePassState::Stage::SEPARATE_FREE_CHUNKS &&
+        state.stage_ != PagePassState::Stage::RELOCATE_ENTRIES)
+    {
+        return false;
+    }
+
+    const SizeType pageIndex = FindSortedChunkPageIndex (state.sortedPages_, state.chunkSize_, chunk);
+    const SizeType selectionIndex = state.selectionIndices_[pageIndex];
+
+    if (selectionIndex == PagePassState::NOT_SELECTED)
+    {
+        return false;
+    }
+
+    if (state.kind_ == PagePassState::Kind::COMPACT)
+    {
+        const auto chunkIndex = static_cast <SizeType> (
+            (static_cast <uint8_t *> (chunk) -
+             static_cast <uint8_t *> (PageDetail::GetFirstChunk (state.sortedPages_[pageIndex]))) / state.chunkSize_);
 
-PagePointer NextPage (PagePointer current) noexcept;
+        state.isSelectedChunkFree_[selectionIndex * state.flagsStride_ + chunkIndex] = true;
+    }
 
-void SetNextPage (PagePointer page, PagePointer next) noexcept;
+    PushPassChunk (state.topHeldChunk_, state.lastHeldChunk_, chunk);
+    return true;
 }
 
-namespace PoolDetail
-{
-void AssertPoolState (BasePoolFields &fields, SizeType chunkSize) noexcept
+void AbandonSelectedPages (BasePoolFields &fields, PagePassState &state) noexcept
 {
-    assert (chunkSize >= sizeof (uintptr_t));
-    assert (fields.pageCapacity_ > 0u);
-    assert (!fields.topFreeChunk_ || fields.topPage_);
+    // Held list mixes chunks of evacuated and abandoned pages, so free chunks of abandoned ones are found by flags.
+    state.topHeldChunk_ = nullptr;
+    state.lastHeldChunk_ = nullptr;
 
-    assert (std::count_if (
-        PageDetail::PageIterator::Begin (fields),
-        PageDetail::PageIterator::End (fields),
-        [] (PagePointer page)
+    for (SizeType selectionIndex = state.currentSelection_; selectionIndex < state.selectedPages_.size ();
+         ++selectionIndex)
+    {
+        const SizeType pageIndex = state.selectedPages_[selectionIndex];
+        const SizeType pageCapacity = PageDetail::GetCapacity (state.sortedPages_[pageIndex]);
+        ChunkPointer chunk = PageDetail::GetFirstChunk (state.sortedPages_[pageIndex]);
+
+        for (SizeType chunkIndex = 0u; chunkIndex < pageCapacity; ++chunkIndex)
         {
-            return true;
-        }) == fields.pageCount_);
+            if (state.isSelectedChunkFree_[selectionIndex * state.flagsStride_ + chunkIndex])
+            {
+                PushFreeChunk (fields, chunk);
+            }
+
+            chunk = PageDetail::NextChunk (chunk, state.chunkSize_);
+        }
+
+        state.selectionIndices_[pageIndex] = PagePassState::NOT_SELECTED;
+    }
+
+    state.selectedPages_.resize (state.currentSelection_);
+    state.currentChunkIndex_ = 0u;
 }
 
-void AssertFromPool (BasePoolFields &fields, void *entry, SizeType chunkSize) noexcept
+void ReleasePassPage (BasePoolFields &fields, PagePassState &state) noexcept
 {
-    assert (std::find_if (
-        PageDetail::PageIterator::Begin (fields),
-        PageDetail::PageIterator::End (fields),
+    assert (state.currentPage_);
+    PagePointer page = state.currentPage_;
+    PagePointer next = PageDetail::NextPage (page);
 
-        [entry, &fields, chunkSize] (PagePointer page)
-        {
-            return PageDetail::IsFrom (page, fields.pageCapacity_, chunkSize, entry);
-        }) != PageDetail::PageIterator::End (fields));
+    const auto pageIndex = static_cast <SizeType> (
+        std::lower_bound (state.sortedPages_.begin (), state.sortedPages_.end (), page) - state.sortedPages_.begin ());
+    assert (state.sortedPages_[pageIndex] == page);
+
+    if (state.selectionIndices_[pageIndex] != PagePassState::NOT_SELECTED)
+    {
+        PopPage (fields, state.chunkSize_, page, state.previousPage_, next);
+    }
+    else
+    {
+        state.previousPage_ = page;
+    }
+
+    state.currentPage_ = next;
 }
 
-void *Acquire (BasePoolFields &fields, SizeType chunkSize) noexcept
+void RelocatePageUsage (BasePoolFields &fields, SizeType chunkSize, ChunkPointer source, ChunkPointer target) noexcept
 {
-    AssertPoolState (fields, chunkSize);
-    if (!fields.topFreeChunk_)
+    if (!fields.pageUsageState_)
     {
-        PagePointer newPage = PageDetail::ConstructEmptyPage (fields.pageCapacity_, chunkSize);
-        ChunkPointer first = PageDetail::GetFirstChunk (newPage);
-        ChunkPointer last = PageDetail::GetLastChunk (fields.pageCapacity_, chunkSize, first);
+        return;
+    }
 
-        *static_cast <uintptr_t *> (last) = reinterpret_cast <uintptr_t> (fields.topFreeChunk_);
-        fields.topFreeChunk_ = first;
-        PushPage (fields, newPage);
-        assert (fields.topFreeChunk_);
+    PageUsageState &usage = *fields.pageUsageState_;
+    SizeType &targetLiveChunkCount =
+        usage.liveChunkCounts_[FindSortedChunkPageIndex (usage.sortedPages_, chunkSize, target)];
+
+    if (targetLiveChunkCount++ == 0u)
+    {
+        --usage.emptyPageCount_;
     }
 
-    return PopFreeChunk (fields);
+    // Evacuated source pages are released by compaction itself, so empty page count does not trigger release here.
+    SizeType &sourceLiveChunkCount =
+        usage.liveChunkCounts_[FindSortedChunkPageIndex (usage.sortedPages_, chunkSize, source)];
+
+    assert (sourceLiveChunkCount > 0u);
+    if (--sourceLiveChunkCount == 0u)
+    {
+        ++usage.emptyPageCount_;
+    }
 }
 
-void Free (BasePoolFields &fields, void *entry, SizeType chunkSize) noexcept
+void CollectSortedPages (BasePoolFields &fields, std::vector <PagePointer> &output) noexcept
 {
-    AssertPoolState (fields, chunkSize);
-    AssertFromPool (fields, entry, chunkSize);
-    PushFreeChunk (fields, entry);
+    output.clear ();
+    output.reserve (fields.pageCount_);
+    output.insert (output.end (), PageDetail::PageIterator::Begin (fields), PageDetail::PageIterator::End (fields));
+    std::sort (output.begin (), output.end ());
 }
 
-void TrivialClean (BasePoolFields &fields, SizeType chunkSize) noexcept
+SizeType FindSortedChunkPageIndex (const std::vector <PagePointer> &sortedPages, [[maybe_unused]] SizeType chunkSize,
+                                   ChunkPointer chunk) noexcept
 {
-    AssertPoolState (fields, chunkSize);
-    PageDetail::PageIterator iterator = PageDetail::PageIterator::Begin (fields);
-    PageDetail::PageIterator end = PageDetail::PageIterator::End (fields);
+    // Pages never overlap, therefore chunk belongs to the last page, that starts before it.
+    auto iterator = std::upper_bound (sortedPages.begin (), sortedPages.end (), chunk);
+    assert (iterator != sortedPages.begin ());
+    --iterator;
 
-    while (iterator != end)
+    assert (PageDetail::IsFrom (*iterator, chunkSize, chunk));
+    return static_cast <SizeType> (iterator - sortedPages.begin ());
+}
+
+SizeType GetNewPageCapacity (const BasePoolFields &fields, SizeType pageCount) noexcept
+{
+    SizeType capacity = fields.pageCapacity_;
+    for (SizeType pageIndex = 0u; pageIndex < pageCount && capacity < fields.maxPageCapacity_; ++pageIndex)
     {
-        PagePointer page = *iterator;
-        ++iterator;
-        free (page);
+        capacity = capacity > fields.maxPageCapacity_ / 2u ? fields.maxPageCapacity_ : capacity * 2u;
     }
 
-    fields.topFreeChunk_ = nullptr;
-    fields.topPage_ = nullptr;
+    return capacity;
 }
 
-void Shrink (BasePoolFields &fields, SizeType chunkSize) noexcept
+void RebuildPageUsage (BasePoolFields &fields, SizeType chunkSize) noexcept
 {
-    AssertPoolState (fields, chunkSize);
-    // TODO: Static thread local is used to avoid vector allocation during this call. Rethink about this solution.
-    static thread_local std::vector <SizeType> freeChunkCounts {};
+    assert (fields.pageUsageState_);
+    assert (!fields.shrinkStepState_);
+    assert (!fields.compactState_);
+    assert (fields.pageUsageState_->releaseStage_ == PageUsageState::ReleaseStage::IDLE);
+    PageUsageState &usage = *fields.pageUsageState_;
+
+    CollectSortedPages (fields, usage.sortedPages_);
+    usage.liveChunkCounts_.resize (usage.sortedPages_.size ());
+    std::transform (usage.sortedPages_.begin (), usage.sortedPages_.end (), usage.liveChunkCounts_.begin (),
+                    PageDetail::GetCapacity);
+
+    for (ChunkPointer freeChunk = fields.topFreeChunk_; freeChunk; freeChunk = NextFreeChunk (freeChunk))
+    {
+        --usage.liveChunkCounts_[FindSortedChunkPageIndex (usage.sortedPages_, chunkSize, freeChunk)];
+    }
 
-    freeChunkCounts.resize (fields.pageCount_);
-    // TODO: Check shrink_to_fit performance foot print and think if it really makes things better.
-    freeChunkCounts.shrink_to_fit ();
-    std::fill (freeChunkCounts.begin (), freeChunkCounts.end (), 0u);
+    usage.emptyPageCount_ = static_cast <SizeType> (
+        std::count (usage.liveChunkCounts_.begin (), usage.liveChunkCounts_.end (), 0u));
+}
 
-    ChunkPointer freeChunk = fields.topFreeChunk_;
-    const PageDetail::PageIterator pagesEnd = PageDetail::PageIterator::End (fields);
+bool IsPageReleaseInProgress (const BasePoolFields &fields) noexcept
+{
+    return fields.pageUsageState_ && fields.pageUsageState_->releaseStage_ != PageUsageState::ReleaseStage::IDLE;
+}
 
-    // Count free chunks on each page.
-    while (freeChunk)
+void StartPageRelease (BasePoolFields &fields) noexcept
+{
+    // Incremental shrink and compaction may hold free chunks of empty pages, they must be in free list to be unlinked.
+    CancelShrinkStep (fields);
+    CancelCompact (fields);
+    assert (fields.pageUsageState_);
+    PageUsageState &usage = *fields.pageUsageState_;
+    assert (usage.releaseStage_ == PageUsageState::ReleaseStage::IDLE);
+
+    if (usage.emptyPageCount_ <= fields.pageReleasePolicy_.sparePageCount_)
     {
-        SizeType pageIndex;
-        PagePointer page = FindChunkPage (fields, chunkSize, freeChunk, pageIndex);
-        // TODO: Should situations where page is not found be processed?
-        assert (page);
-        assert (pageIndex < fields.pageCount_);
-
-        ++freeChunkCounts[pageIndex];
-        freeChunk = NextFreeChunk (freeChunk);
+        return;
     }
 
-    // Erase from list free chunks of empty pages.
+    SizeType releaseCount = usage.emptyPageCount_ - fields.pageReleasePolicy_.sparePageCount_;
+    for (SizeType &liveChunkCount : usage.liveChunkCounts_)
     {
-        ChunkPointer previous = nullptr;
-        freeChunk = fields.topFreeChunk_;
+        if (releaseCount == 0u)
+        {
+            break;
+        }
 
-        while (freeChunk)
+        if (liveChunkCount == 0u)
         {
-            SizeType pageIndex;
-            PagePointer page = FindChunkPage (fields, chunkSize, freeChunk, pageIndex);
-            // TODO: Should situations where page is not found be processed?
-            assert (page);
-            assert (pageIndex < fields.pageCount_);
+            liveChunkCount = PageUsageState::RELEASED_PAGE_MARK;
+            --releaseCount;
+        }
+    }
+
+    // Marked pages have no live chunks, therefore chunks, freed during release, never belong to them.
+    usage.topUncheckedChunk_ = fields.topFreeChunk_;
+    fields.topFreeChunk_ = nullptr;
+    usage.releaseStage_ = PageUsageState::ReleaseStage::UNLINK_CHUNKS;
+}
+
+bool PageReleaseStep (BasePoolFields &fields, SizeType chunkSize, SizeType budget) noexcept
+{
+    assert (fields.pageUsageState_);
+    PageUsageState &usage = *fields.pageUsageState_;
 
-            assert (freeChunkCounts[pageIndex] <= fields.pageCapacity_);
-            ChunkPointer next = NextFreeChunk (freeChunk);
+    while (budget > 0u)
+    {
+        switch (usage.releaseStage_)
+        {
+            case PageUsageState::ReleaseStage::IDLE:
+            {
+                return true;
+            }
 
-            if (freeChunkCounts[pageIndex] == fields.pageCapacity_)
+            case PageUsageState::ReleaseStage::UNLINK_CHUNKS:
             {
-                if (previous)
+                if (!usage.topUncheckedChunk_)
                 {
-                    SetNextFreeChunk (previous, next);
+                    usage.releaseStage_ = PageUsageState::ReleaseStage::POP_PAGES;
+                    usage.previousPage_ = nullptr;
+                    usage.currentPage_ = fields.topPage_;
+                    break;
                 }
-                else
+
+                ChunkPointer chunk = usage.topUncheckedChunk_;
+                usage.topUncheckedChunk_ = NextFreeChunk (chunk);
+
+                if (usage.liveChunkCounts_[FindSortedChunkPageIndex (usage.sortedPages_, chunkSize, chunk)] !=
+                    PageUsageState::RELEASED_PAGE_MARK)
                 {
-                    fields.topFreeChunk_ = next;
+                    PushFreeChunk (fields, chunk);
                 }
+
+                --budget;
+                break;
             }
-            else
+
+            case PageUsageState::ReleaseStage::POP_PAGES:
             {
-                previous = freeChunk;
-            }
+                if (!usage.currentPage_)
+                {
+                    usage.releaseStage_ = PageUsageState::ReleaseStage::IDLE;
+                    usage.previousPage_ = nullptr;
+                    return true;
+                }
 
-            freeChunk = next;
-        }
-    }
+                PagePointer page = usage.currentPage_;
+                PagePointer next = PageDetail::NextPage (page);
 
-    // Erase empty pages.
-    {
-        SizeType pageIndex = 0u;
-        PagePointer previousPage = nullptr;
-        PageDetail::PageIterator pageIterator = PageDetail::PageIterator::Begin (fields);
+                const auto pageIndex = static_cast <SizeType> (
+                    std::lower_bound (usage.sortedPages_.begin (), usage.sortedPages_.end (), page) -
+                    usage.sortedPages_.begin ());
 
-        while (pageIterator != pagesEnd)
-        {
-            PagePointer currentPage = *pageIterator;
-            ++pageIterator;
-            assert (freeChunkCounts[pageIndex] <= fields.pageCapacity_);
+                if (usage.liveChunkCounts_[pageIndex] == PageUsageState::RELEASED_PAGE_MARK)
+                {
+                    PopPage (fields, chunkSize, page, usage.previousPage_, next);
+                }
+                else
+                {
+                    usage.previousPage_ = page;
+                }
 
-            if (freeChunkCounts[pageIndex] == fields.pageCapacity_)
-            {
-                PopPage (fields, currentPage, previousPage, *pageIterator);
-            }
-            else
-            {
-                previousPage = currentPage;
+                usage.currentPage_ = next;
+                --budget;
+                break;
             }
-
-            ++pageIndex;
         }
     }
-}
 
-ChunkPointer NextFreeChunk (ChunkPointer current) noexcept
-{
-    assert (current);
-    return reinterpret_cast <ChunkPointer> (*static_cast <uintptr_t *> (current));
+    return usage.releaseStage_ == PageUsageState::ReleaseStage::IDLE;
+}
 }
 
-PagePointer FindChunkPage (BasePoolFields &fields, SizeType chunkSize,
-                           ChunkPointer chunk, SizeType &pageIndexOutput) noexcept
+namespace PageDetail
 {
-    pageIndexOutput = 0u;
-    PageDetail::PageIterator pageIterator = PageDetail::PageIterator::Begin (fields);
-    const PageDetail::PageIterator pagesEnd = PageDetail::PageIterator::End (fields);
-
-    while (pageIterator != pagesEnd)
-    {
-        if (PageDetail::IsFrom (*pageIterator, fields.pageCapacity_, chunkSize, chunk))
-        {
-            return *pageIterator;
-        }
-        else
-        {
-            ++pageIterator;
-            ++pageIndexOutput;
-        }
-    }
-
-    return nullptr;
+SizeType GetCapacity (PagePointer page) noexcept
+{
+    assert (page);
+    return static_cast <SizeType> (*(static_cast <uintptr_t *> (page) + 1u));
 }
 
-void SetNextFreeChunk (ChunkPointer chunk, ChunkPointer next) noexcept
+PageOwner GetOwner (PagePointer page) noexcept
 {
-    *static_cast <uintptr_t *> (chunk) = reinterpret_cast <uintptr_t> (next);
+    assert (page);
+    const auto *header = reinterpret_cast <const uintptr_t *> (static_cast <uint8_t *> (page) - OWNER_HEADER_SIZE);
+    return {reinterpret_cast <void *> (header[0u]), reinterpret_cast <OwnedEntryFree> (header[1u])};
 }
 
-void PushFreeChunk (BasePoolFields &fields, ChunkPointer chunk) noexcept
+void SetOwner (PagePointer page, const PageOwner &owner) noexcept
 {
-    SetNextFreeChunk (chunk, fields.topFreeChunk_);
-    fields.topFreeChunk_ = chunk;
+    assert (page);
+    auto *header = reinterpret_cast <uintptr_t *> (static_cast <uint8_t *> (page) - OWNER_HEADER_SIZE);
+    header[0u] = reinterpret_cast <uintptr_t> (owner.pool_);
+    header[1u] = reinterpret_cast <uintptr_t> (owner.free_);
 }
 
-ChunkPointer PopFreeChunk (BasePoolFields &fields) noexcept
+PagePointer GetOwnedChunkPage (const void *chunk) noexcept
 {
-    assert (fields.topFreeChunk_);
-    ChunkPointer current = fields.topFreeChunk_;
-    fields.topFreeChunk_ = NextFreeChunk (current);
-    return current;
+    assert (chunk);
+    const uintptr_t block =
+        reinterpret_cast <uintptr_t> (chunk) & ~static_cast <uintptr_t> (OWNED_PAGE_ALIGNMENT - 1u);
+    return reinterpret_cast <PagePointer> (block + OWNER_HEADER_SIZE);
 }
 
-void PushPage (BasePoolFields &fields, PagePointer page) noexcept
+SizeType GetMaxOwnedPageCapacity (SizeType chunkSize) noexcept
 {
-    PageDetail::SetNextPage (page, fields.topPage_);
-    fields.topPage_ = page;
-    ++fields.pageCount_;
+    assert (chunkSize >= sizeof (uintptr_t));
+    return static_cast <SizeType> ((OWNED_PAGE_ALIGNMENT - OWNER_HEADER_SIZE - PAGE_HEADER_SIZE) / chunkSize);
 }
 
-void PopPage (BasePoolFields &fields, PagePointer page, PagePointer previous, PagePointer next) noexcept
+SizeType CalculatePageCapacity (PageSize pageSize, SizeType chunkSize) noexcept
 {
-    assert (fields.pageCount_);
-    assert (page);
-    assert (PageDetail::NextPage (page) == next);
-    assert (!previous || PageDetail::NextPage (previous) == page);
-
-    free (page);
-    --fields.pageCount_;
+    assert (chunkSize >= sizeof (uintptr_t));
+    assert (pageSize.bytes_ >= PAGE_HEADER_SIZE + chunkSize);
 
-    if (previous)
+    // Assert above is not checked in release builds, so size is compared before subtraction to avoid underflow.
+    const std::size_t headersSize = PAGE_HEADER_SIZE + ALLOCATION_OVERHEAD;
+    if (pageSize.bytes_ < headersSize + chunkSize)
     {
-        PageDetail::SetNextPage (previous, next);
-    }
-    else
-    {
-        fields.topPage_ = next;
+        return 1u;
     }
-}
+
+    return static_cast <SizeType> ((pageSize.bytes_ - headersSize) / chunkSize);
 }
 
-namespace PageDetail
-{
 ChunkPointer GetFirstChunk (PagePointer page) noexcept
 {
-    return static_cast <ChunkPointer> (static_cast <uintptr_t *> (page) + 1u);
+    return static_cast <ChunkPointer> (static_cast <uint8_t *> (page) + PAGE_HEADER_SIZE);
 }
 
-ChunkPointer GetLastChunk (SizeType pageCapacity, SizeType chunkSize, ChunkPointer firstChunk) noexcept
+ChunkPointer GetLastChunk (PagePointer page, SizeType chunkSize) noexcept
 {
-    return static_cast <ChunkPointer> (static_cast <uint8_t *> (firstChunk) + (pageCapacity - 1u) * chunkSize);
+    return static_cast <ChunkPointer> (
+        static_cast <uint8_t *> (GetFirstChunk (page)) + (GetCapacity (page) - 1u) * chunkSize);
 }
 
-bool IsFrom (PagePointer page, SizeType pageCapacity, SizeType chunkSize, ChunkPointer chunk) noexcept
+bool IsFrom (PagePointer page, SizeType chunkSize, ChunkPointer chunk) noexcept
 {
     assert (page);
-    void *firstChunk = static_cast <void *> (static_cast <uintptr_t *> (page) + 1u);
-    void *lastChunk = static_cast <void *> (static_cast <uint8_t *> (firstChunk) + (pageCapacity - 1u) * chunkSize);
-    return chunk >= firstChunk && chunk <= lastChunk;
+    return chunk >= GetFirstChunk (page) && chunk <= GetLastChunk (page, chunkSize);
 }
 
 ChunkPointer NextChunk (ChunkPointer current, SizeType chunkSize) noexcept
@@ -334,18 +1778,58 @@ PageIterator::PageIterator (PagePointer page) noexcept
 {
 }
 
-PagePointer ConstructEmptyPage (SizeType pageCapacity, SizeType chunkSize) noexcept
+std::size_t GetPageSize (SizeType pageCapacity, SizeType chunkSize) noexcept
 {
-    assert (pageCapacity > 0u);
-    assert (chunkSize >= sizeof (uintptr_t));
+    return PAGE_HEADER_SIZE + static_cast <std::size_t> (pageCapacity) * chunkSize;
+}
 
+PagePointer AllocatePage (SizeType pageCapacity, SizeType chunkSize) noexcept
+{
+    assert (pageCapacity > 0u);
     // TODO: Handle malloc errors?
-    PagePointer page = malloc (sizeof (uintptr_t) + pageCapacity * chunkSize);
+    PagePointer page = malloc (GetPageSize (pageCapacity, chunkSize));
+    assert (page);
+
+    SetNextPage (page, nullptr);
+    SetCapacity (page, pageCapacity);
+    return page;
+}
+
+PagePointer ConstructEmptyPage (SizeType pageCapacity, SizeType chunkSize) noexcept
+{
+    PagePointer page = AllocatePage (pageCapacity, chunkSize);
+    InitializeEmptyPage (page, chunkSize);
+    return page;
+}
+
+void SetCapacity (PagePointer page, SizeType pageCapacity) noexcept
+{
+    assert (page);
+    *(static_cast <uintptr_t *> (page) + 1u) = pageCapacity;
+}
+
+void Decommit (PagePointer page, SizeType chunkSize) noexcept
+{
+    const std::size_t systemPageSize = VirtualMemory::GetPageSize ();
+    const auto pageBegin = reinterpret_cast <uintptr_t> (page);
+    const uintptr_t begin = (pageBegin + PAGE_HEADER_SIZE + systemPageSize - 1u) / systemPageSize * systemPageSize;
+    const uintptr_t end = (pageBegin + GetPageSize (GetCapacity (page), chunkSize)) / systemPageSize * systemPageSize;
+
+    if (begin < end)
+    {
+        VirtualMemory::Decommit (reinterpret_cast <void *> (begin), end - begin);
+    }
+}
+
+void InitializeEmptyPage (PagePointer page, SizeType chunkSize) noexcept
+{
     assert (page);
+    assert (GetCapacity (page) > 0u);
+    assert (chunkSize >= sizeof (uintptr_t));
 
     ChunkPointer previous = GetFirstChunk (page);
     ChunkPointer current = NextChunk (previous, chunkSize);
-    ChunkPointer last = GetLastChunk (pageCapacity, chunkSize, previous);
+    ChunkPointer last = GetLastChunk (page, chunkSize);
 
     while (current <= last)
     {
@@ -353,8 +1837,6 @@ PagePointer ConstructEmptyPage (SizeType pageCapacity, SizeType chunkSize) noexc
         previous = current;
         current = NextChunk (current, chunkSize);
     }
-
-    return page;
 }
 
 PagePointer NextPage (PagePointer current) noexcept
@@ -368,4 +1850,4 @@ void SetNextPage (PagePointer page, PagePointer next) noexcept
     *static_cast <uintptr_t *> (page) = reinterpret_cast <uintptr_t> (next);
 }
 }
-}
+}
\ No newline at end of file
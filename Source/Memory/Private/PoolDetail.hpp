@@ -1,21 +1,70 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <vector>
 
+#include <Memory/ParallelExecutor.hpp>
 #include <Memory/Private/Commons.hpp>
 
 namespace Memory
 {
 namespace PageDetail
 {
+// Page header consists of pointer to next page and page capacity. Capacity is stored in every page,
+// because pools with page capacity growth contain pages of different sizes.
+constexpr std::size_t PAGE_HEADER_SIZE = 2u * sizeof (uintptr_t);
+
+// Pages are allocated by malloc, which stores its own header before every allocation. Page size, requested by user,
+// is reduced by this estimate, so page together with malloc header does not spill into next operating system page.
+constexpr std::size_t ALLOCATION_OVERHEAD = 2u * sizeof (std::size_t);
+
+// Pages of pools with owner lookup are placed into blocks, that are aligned to this value, so block is found by
+// masking chunk address. Block starts with owner header, page follows it, so other pages do not pay for owner.
+constexpr std::size_t OWNED_PAGE_ALIGNMENT = 65536u;
+
+// Owner header consists of owner pool pointer and owner free function.
+constexpr std::size_t OWNER_HEADER_SIZE = 2u * sizeof (uintptr_t);
+
+SizeType GetCapacity (PagePointer page) noexcept;
+
+// Owner is stored only in pages of pools with owner lookup.
+PageOwner GetOwner (PagePointer page) noexcept;
+
+void SetOwner (PagePointer page, const PageOwner &owner) noexcept;
+
+// Returns page of pool with owner lookup, that contains given chunk.
+PagePointer GetOwnedChunkPage (const void *chunk) noexcept;
+
+// Returns max count of chunks, that fit into page of pool with owner lookup.
+SizeType GetMaxOwnedPageCapacity (SizeType chunkSize) noexcept;
+
+// Returns max count of chunks, that fit into page of given size together with page and malloc headers.
+// Page always has at least one chunk, even if requested size is too small for it.
+SizeType CalculatePageCapacity (PageSize pageSize, SizeType chunkSize) noexcept;
+
+std::size_t GetPageSize (SizeType pageCapacity, SizeType chunkSize) noexcept;
+
+// Allocates page with given capacity and no next page. Chunks are left uninitialized.
+PagePointer AllocatePage (SizeType pageCapacity, SizeType chunkSize) noexcept;
+
+// Allocates page with given capacity and no next page. All chunks are linked into one list, see GetFirstChunk.
+PagePointer ConstructEmptyPage (SizeType pageCapacity, SizeType chunkSize) noexcept;
+
 ChunkPointer GetFirstChunk (PagePointer page) noexcept;
 
-ChunkPointer GetLastChunk (SizeType pageCapacity, SizeType chunkSize, ChunkPointer firstChunk) noexcept;
+ChunkPointer GetLastChunk (PagePointer page, SizeType chunkSize) noexcept;
 
-bool IsFrom (PagePointer page, SizeType pageCapacity, SizeType chunkSize, ChunkPointer chunk) noexcept;
+bool IsFrom (PagePointer page, SizeType chunkSize, ChunkPointer chunk) noexcept;
 
 ChunkPointer NextChunk (ChunkPointer current, SizeType chunkSize) noexcept;
 
+PagePointer NextPage (PagePointer current) noexcept;
+
+void SetNextPage (PagePointer page, PagePointer next) noexcept;
+
 class PageIterator
 {
 public:
@@ -54,85 +103,255 @@ void *Acquire (BasePoolFields &fields, SizeType chunkSize) noexcept;
 
 void Free (BasePoolFields &fields, void *entry, SizeType chunkSize) noexcept;
 
+// Allocates pages until pool is able to hold entryCount entries without allocations. New pages are allocated as one
+// continuous block. If prefault is requested, every memory page of the block is touched, so operating system commits
+// it right away, and pages are added to pool. Otherwise pages are kept like released pages: only their headers are
+// written, pool takes them when it runs out of free chunks, so their memory is committed and page count grows on use.
+void Reserve (BasePoolFields &fields, SizeType chunkSize, SizeType entryCount, bool prefault) noexcept;
+
+// Changes what happens with pages, that are released from pool. See ReleasedPageMode.
+void SetReleasedPageMode (BasePoolFields &fields, ReleasedPageMode mode) noexcept;
+
+// Enables page capacity growth: capacity of every new page is doubled until it reaches given max capacity.
+// Only new pages are affected, existing pages keep their capacity. Capacity of pools with owner lookup is
+// clamped, so their pages fit into owned page blocks.
+void SetMaxPageCapacity (BasePoolFields &fields, SizeType chunkSize, SizeType maxPageCapacity) noexcept;
+
+// Released pages, that are not kept by pool, are deposited into given depot and new pages are withdrawn from it
+// before allocator is called. Null depot disables sharing.
+void SetPageDepot (BasePoolFields &fields, PageDepot *depot) noexcept;
+
+// New pages are taken from given provisioner if their capacity matches provisioner page capacity. Chunk size of
+// provisioner must be equal to pool chunk size. Null provisioner disables background page construction.
+void SetPageProvisioner (BasePoolFields &fields, SizeType chunkSize, PageProvisioner *provisioner) noexcept;
+
+// Enables owner lookup for empty pool or updates owner of existing pages, for example, after pool was moved.
+// New pages of such pool are placed into blocks, aligned to OWNED_PAGE_ALIGNMENT, and are not shared through
+// depot or provisioner. Page capacity is clamped to GetMaxOwnedPageCapacity. Returns false and leaves owner
+// lookup disabled if even one chunk does not fit into owned page block.
+bool SetPageOwner (BasePoolFields &fields, SizeType chunkSize, const PageOwner &owner) noexcept;
+
+// Frees entry of any pool with owner lookup through owner, that is stored in page header.
+void FreeOwnedEntry (void *entry) noexcept;
+
 void TrivialClean (BasePoolFields &fields, SizeType chunkSize) noexcept;
 
 // Template to help compiler optimize this method for typed pools.
 template <typename Destructor>
 void NonTrivialClean (BasePoolFields &fields, SizeType chunkSize, const Destructor &destructor) noexcept;
 
+// Destructs used chunks of disjoint page ranges in parallel using given executor and then releases pages.
+template <typename Destructor>
+void NonTrivialClean (BasePoolFields &fields, SizeType chunkSize, const Destructor &destructor,
+                      const ParallelExecutor &executor, SizeType pagesPerTask) noexcept;
+
+// Calls destructor for each used chunk of given page. Expects that free list, that starts from nextFreeChunk,
+// is sorted by address and has no chunks before given page. Returns first free chunk after given page.
+template <typename Destructor>
+ChunkPointer DestructUsedChunks (PagePointer page, SizeType chunkSize, ChunkPointer nextFreeChunk,
+                                 const Destructor &destructor) noexcept;
+
 void Shrink (BasePoolFields &fields, SizeType chunkSize) noexcept;
 
-ChunkPointer NextFreeChunk (ChunkPointer current) noexcept;
+// Does the same thing as Shrink, but processes no more than budget units per call and continues from the point where
+// previous call stopped. Unit is one step of page release in progress, one collected, sorted or checked page, one free
+// chunk or one released page, each takes no more than logarithmic time in page count. Returns true if shrink pass is
+// finished. Incremental shrink holds part of free chunks while in progress, therefore if pool runs out of free
+// chunks, pass is cancelled. Compaction in progress is cancelled too, or finished within budget if it already
+// releases pages.
+bool ShrinkStep (BasePoolFields &fields, SizeType chunkSize, SizeType budget) noexcept;
+
+// Returns all free chunks, that are held by incremental shrink, back to pool and discards shrink state.
+void CancelShrinkStep (BasePoolFields &fields) noexcept;
+
+// Moves source chunk content to target chunk. Source chunk must be treated as free after relocation.
+using RelocationCallback = void (*) (void *context, ChunkPointer source, ChunkPointer target) noexcept;
+
+// Moves live entries from the most sparse pages to free chunks of other pages and releases emptied pages. Works
+// like ShrinkStep and uses the same units, additionally every page ordered by sparsity and every source chunk is one
+// unit. Returns true if compaction pass is finished or there is nothing to compact.
+// Compaction holds free chunks of source pages while in progress, therefore if pool runs out of free chunks or
+// new pages are added, pass is cancelled.
+bool Compact (BasePoolFields &fields, SizeType chunkSize, SizeType budget,
+              RelocationCallback relocate, void *context) noexcept;
+
+// Returns all free chunks, that are held by incremental compaction, back to pool and discards compaction state.
+void CancelCompact (BasePoolFields &fields) noexcept;
+
+// Page release policy unlinks free chunks and pages of released pages gradually during Acquire and Free.
+// Finishes release in progress, so free list contains all free chunks and page list contains no released pages.
+void FinishPageRelease (BasePoolFields &fields, SizeType chunkSize) noexcept;
+
+template <typename Relocator>
+bool Compact (BasePoolFields &fields, SizeType chunkSize, SizeType budget, const Relocator &relocator) noexcept;
 
-PagePointer FindChunkPage (BasePoolFields &fields, SizeType chunkSize,
-                           ChunkPointer chunk, SizeType &pageIndexOutput) noexcept;
+// Changes automatic empty page release policy. Live chunk counts of pages are tracked during Acquire and Free
+// only when policy is not never, therefore pools without policy do not pay for tracking.
+void SetPageReleasePolicy (BasePoolFields &fields, SizeType chunkSize, const PageReleasePolicy &policy) noexcept;
+
+// Free list functions are inline, because pools with compile time geometry use them in their inlined fast paths.
+inline ChunkPointer NextFreeChunk (ChunkPointer current) noexcept;
+
+inline void SetNextFreeChunk (ChunkPointer chunk, ChunkPointer next) noexcept;
+
+// Detaches no more than maxCount chunks from pool free list, returns top of detached list and writes its size to
+// detachedCount. If there are no free chunks, new page is constructed. Used by concurrent pools, that distribute
+// free chunks between shards. Page release policy must be never.
+ChunkPointer DetachFreeChunks (BasePoolFields &fields, SizeType chunkSize, SizeType maxCount,
+                               SizeType &detachedCount) noexcept;
+
+// Links list of free chunks, that starts from top and ends with last, back into pool free list.
+void AttachFreeChunks (BasePoolFields &fields, ChunkPointer top, ChunkPointer last) noexcept;
+
+// Sorts free chunks list by chunk addresses in O(n log n) without additional memory allocations.
+void SortFreeChunks (BasePoolFields &fields) noexcept;
+
+// Same as above, but for free list, that is not stored in pool fields. Returns new top of the list.
+ChunkPointer SortFreeChunks (ChunkPointer topFreeChunk) noexcept;
+
+// Sorts pages list by page addresses in O(n log n) without additional memory allocations.
+void SortPages (BasePoolFields &fields) noexcept;
 }
 
 namespace PoolDetail
 {
+inline ChunkPointer NextFreeChunk (ChunkPointer current) noexcept
+{
+    assert (current);
+    return reinterpret_cast <ChunkPointer> (*static_cast <uintptr_t *> (current));
+}
+
+inline void SetNextFreeChunk (ChunkPointer chunk, ChunkPointer next) noexcept
+{
+    *static_cast <uintptr_t *> (chunk) = reinterpret_cast <uintptr_t> (next);
+}
+
+template <typename Relocator>
+bool Compact (BasePoolFields &fields, SizeType chunkSize, SizeType budget, const Relocator &relocator) noexcept
+{
+    return Compact (
+        fields, chunkSize, budget,
+        [] (void *context, ChunkPointer source, ChunkPointer target) noexcept
+        {
+            (*static_cast <const Relocator *> (context)) (source, target);
+        },
+        const_cast <Relocator *> (&relocator));
+}
+
 template <typename Destructor>
 void NonTrivialClean (BasePoolFields &fields, SizeType chunkSize, const Destructor &destructor) noexcept
 {
+    CancelShrinkStep (fields);
+    CancelCompact (fields);
+    FinishPageRelease (fields, chunkSize);
     AssertPoolState (fields, chunkSize);
-    // TODO: Static thread local is used to avoid vector allocation during this call. Rethink about this solution.
-    static thread_local std::vector <bool> isChunkUsed {};
+    // When both pages and free chunks are sorted by address, used chunks can be found in one
+    // simultaneous pass through pages and free list without any additional memory.
+    SortFreeChunks (fields);
+    SortPages (fields);
 
-    isChunkUsed.resize (fields.pageCount_ * fields.pageCapacity_);
-    // TODO: Check shrink_to_fit performance foot print and think if it really makes things better.
-    isChunkUsed.shrink_to_fit ();
-    std::fill (isChunkUsed.begin (), isChunkUsed.end (), true);
+    ChunkPointer nextFreeChunk = fields.topFreeChunk_;
+    PageDetail::PageIterator pageIterator = PageDetail::PageIterator::Begin (fields);
+    const PageDetail::PageIterator pagesEnd = PageDetail::PageIterator::End (fields);
 
-    // Start from marking free chunks in isChunkUsed vector.
+    while (pageIterator != pagesEnd)
     {
-        ChunkPointer freeChunk = fields.topFreeChunk_;
-        while (freeChunk)
-        {
-            SizeType pageIndex;
-            PagePointer page = FindChunkPage (fields, chunkSize, freeChunk, pageIndex);
-            // TODO: Should situations where page is not found be processed?
-            assert (page);
-            assert (pageIndex < fields.pageCount_);
+        nextFreeChunk = DestructUsedChunks (*pageIterator, chunkSize, nextFreeChunk, destructor);
+        ++pageIterator;
+    }
 
-            ChunkPointer pageFirstChunk = PageDetail::GetFirstChunk (page);
-            assert (pageFirstChunk <= freeChunk);
+    assert (!nextFreeChunk);
+    // Now we can execute trivial clean, because all used chunks are destructed.
+    TrivialClean (fields, chunkSize);
+}
+
+template <typename Destructor>
+void NonTrivialClean (BasePoolFields &fields, SizeType chunkSize, const Destructor &destructor,
+                      const ParallelExecutor &executor, SizeType pagesPerTask) noexcept
+{
+    CancelShrinkStep (fields);
+    CancelCompact (fields);
+    FinishPageRelease (fields, chunkSize);
+    AssertPoolState (fields, chunkSize);
+    assert (executor);
+    assert (pagesPerTask > 0u);
 
-            ptrdiff_t chunkIndex =
-                (static_cast <uint8_t *> (freeChunk) - static_cast <uint8_t *> (pageFirstChunk)) / chunkSize;
+    SortFreeChunks (fields);
+    SortPages (fields);
 
-            isChunkUsed[pageIndex * fields.pageCapacity_ + chunkIndex] = false;
-            freeChunk = NextFreeChunk (freeChunk);
-        }
-    }
+    struct TaskStart
+    {
+        PagePointer page_;
+        ChunkPointer nextFreeChunk_;
+    };
+
+    // Find first page and first free chunk of every task in one pass, so tasks can be executed independently.
+    std::vector <TaskStart> taskStarts;
+    taskStarts.reserve ((fields.pageCount_ + pagesPerTask - 1u) / pagesPerTask);
 
-    // Call destructor for each used chunk.
     {
-        size_t chunkGlobalIndex = 0u;
+        SizeType pageIndex = 0u;
+        ChunkPointer freeChunk = fields.topFreeChunk_;
         PageDetail::PageIterator pageIterator = PageDetail::PageIterator::Begin (fields);
         const PageDetail::PageIterator pagesEnd = PageDetail::PageIterator::End (fields);
 
         while (pageIterator != pagesEnd)
         {
-            PagePointer page = *pageIterator;
-            ChunkPointer currentChunk = PageDetail::GetFirstChunk (page);
-            ChunkPointer lastChunk = PageDetail::GetLastChunk (fields.pageCapacity_, chunkSize, currentChunk);
-
-            while (currentChunk <= lastChunk)
+            if (pageIndex % pagesPerTask == 0u)
             {
-                if (isChunkUsed[chunkGlobalIndex])
+                while (freeChunk && freeChunk < *pageIterator)
                 {
-                    destructor (currentChunk);
+                    freeChunk = NextFreeChunk (freeChunk);
                 }
 
-                currentChunk = PageDetail::NextChunk (currentChunk, chunkSize);
-                ++chunkGlobalIndex;
+                taskStarts.push_back ({*pageIterator, freeChunk});
             }
 
             ++pageIterator;
+            ++pageIndex;
         }
     }
 
-    // Now we can execute trivial clean, because all used chunks are destructed.
+    executor (
+        static_cast <SizeType> (taskStarts.size ()),
+        [chunkSize, &destructor, pagesPerTask, &taskStarts] (SizeType taskIndex)
+        {
+            assert (taskIndex < taskStarts.size ());
+            PagePointer page = taskStarts[taskIndex].page_;
+            ChunkPointer nextFreeChunk = taskStarts[taskIndex].nextFreeChunk_;
+
+            for (SizeType pageIndex = 0u; page && pageIndex < pagesPerTask; ++pageIndex)
+            {
+                nextFreeChunk = DestructUsedChunks (page, chunkSize, nextFreeChunk, destructor);
+                page = PageDetail::NextPage (page);
+            }
+        });
+
     TrivialClean (fields, chunkSize);
 }
+
+template <typename Destructor>
+ChunkPointer DestructUsedChunks (PagePointer page, SizeType chunkSize, ChunkPointer nextFreeChunk,
+                                 const Destructor &destructor) noexcept
+{
+    ChunkPointer currentChunk = PageDetail::GetFirstChunk (page);
+    ChunkPointer lastChunk = PageDetail::GetLastChunk (page, chunkSize);
+
+    while (currentChunk <= lastChunk)
+    {
+        if (currentChunk == nextFreeChunk)
+        {
+            nextFreeChunk = NextFreeChunk (nextFreeChunk);
+        }
+        else
+        {
+            destructor (currentChunk);
+        }
+
+        currentChunk = PageDetail::NextChunk (currentChunk, chunkSize);
+    }
+
+    return nextFreeChunk;
+}
 }
 }
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+
+#include <Memory/Private/VirtualMemory.hpp>
+
+#if defined (_WIN32)
+
+#include <malloc.h>
+#include <windows.h>
+
+namespace Memory
+{
+namespace VirtualMemory
+{
+std::size_t GetPageSize () noexcept
+{
+    SYSTEM_INFO info {};
+    GetSystemInfo (&info);
+    return info.dwPageSize;
+}
+
+void Decommit (void *address, std::size_t size) noexcept
+{
+    // MEM_RESET tells system, that content is not needed anymore, but keeps range committed and accessible.
+    [[maybe_unused]] void *result = VirtualAlloc (address, size, MEM_RESET, PAGE_READWRITE);
+    assert (result);
+}
+
+void *AllocateAligned (std::size_t size, std::size_t alignment) noexcept
+{
+    return _aligned_malloc (size, alignment);
+}
+
+void FreeAligned (void *address) noexcept
+{
+    _aligned_free (address);
+}
+
+void *AllocateAlignedPages (std::size_t size, std::size_t alignment) noexcept
+{
+    SYSTEM_INFO info {};
+    GetSystemInfo (&info);
+
+    // Addresses of allocations are multiples of allocation granularity, which is usually 64 KiB.
+    if (alignment <= info.dwAllocationGranularity)
+    {
+        return VirtualAlloc (nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    }
+
+    // Range with margin is reserved only to find aligned address and is released before aligned allocation,
+    // so other thread may take this address in between. In this case attempt is repeated.
+    while (true)
+    {
+        void *reserved = VirtualAlloc (nullptr, size + alignment, MEM_RESERVE, PAGE_NOACCESS);
+        if (!reserved)
+        {
+            return nullptr;
+        }
+
+        const uintptr_t aligned = (reinterpret_cast <uintptr_t> (reserved) + alignment - 1u) & ~(alignment - 1u);
+        VirtualFree (reserved, 0u, MEM_RELEASE);
+
+        if (void *address = VirtualAlloc (
+                reinterpret_cast <void *> (aligned), size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE))
+        {
+            return address;
+        }
+    }
+}
+
+void FreeAlignedPages (void *address, std::size_t size) noexcept
+{
+    [[maybe_unused]] const BOOL result = VirtualFree (address, 0u, MEM_RELEASE);
+    assert (result);
+}
+}
+}
+
+#elif defined (__unix__) || defined (__APPLE__)
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Memory
+{
+namespace VirtualMemory
+{
+std::size_t GetPageSize () noexcept
+{
+    static const auto pageSize = static_cast <std::size_t> (sysconf (_SC_PAGESIZE));
+    return pageSize;
+}
+
+void Decommit (void *address, std::size_t size) noexcept
+{
+    // MADV_DONTNEED is used instead of MADV_FREE, because it releases memory right away
+    // instead of waiting for memory pressure, so resident set size drops as soon as pool shrinks.
+    [[maybe_unused]] const int result = madvise (address, size, MADV_DONTNEED);
+    assert (result == 0);
+}
+
+void *AllocateAligned (std::size_t size, std::size_t alignment) noexcept
+{
+    void *address = nullptr;
+    return posix_memalign (&address, alignment, size) == 0 ? address : nullptr;
+}
+
+void FreeAligned (void *address) noexcept
+{
+    free (address);
+}
+
+void *AllocateAlignedPages (std::size_t size, std::size_t alignment) noexcept
+{
+    const std::size_t pageSize = GetPageSize ();
+    size = (size + pageSize - 1u) / pageSize * pageSize;
+    alignment = std::max (alignment, pageSize);
+
+    // Mapping with margin always contains aligned block, unaligned head and tail are unmapped right away.
+    const std::size_t mappedSize = size + alignment - pageSize;
+    void *mapped = mmap (nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (mapped == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    const auto begin = reinterpret_cast <uintptr_t> (mapped);
+    const uintptr_t aligned = (begin + alignment - 1u) & ~(alignment - 1u);
+    const uintptr_t end = begin + mappedSize;
+
+    if (aligned > begin)
+    {
+        munmap (mapped, aligned - begin);
+    }
+
+    if (aligned + size < end)
+    {
+        munmap (reinterpret_cast <void *> (aligned + size), end - aligned - size);
+    }
+
+    return reinterpret_cast <void *> (aligned);
+}
+
+void FreeAlignedPages (void *address, std::size_t size) noexcept
+{
+    const std::size_t pageSize = GetPageSize ();
+    [[maybe_unused]] const int result = munmap (address, (size + pageSize - 1u) / pageSize * pageSize);
+    assert (result == 0);
+}
+}
+}
+
+#else
+
+namespace Memory
+{
+namespace VirtualMemory
+{
+std::size_t GetPageSize () noexcept
+{
+    return 4096u;
+}
+
+void Decommit ([[maybe_unused]] void *address, [[maybe_unused]] std::size_t size) noexcept
+{
+    // There is no known way to decommit memory on this platform, so memory is just kept.
+}
+
+void *AllocateAligned (std::size_t size, std::size_t alignment) noexcept
+{
+    // Standard aligned allocation requires size to be multiple of alignment.
+    return std::aligned_alloc (alignment, (size + alignment - 1u) / alignment * alignment);
+}
+
+void FreeAligned (void *address) noexcept
+{
+    free (address);
+}
+
+void *AllocateAlignedPages (std::size_t size, std::size_t alignment) noexcept
+{
+    // There is no direct access to operating system, so allocator is used instead.
+    return AllocateAligned (size, alignment);
+}
+
+void FreeAlignedPages (void *address, [[maybe_unused]] std::size_t size) noexcept
+{
+    FreeAligned (address);
+}
+}
+}
+
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Memory
+{
+namespace VirtualMemory
+{
+// Returns size of operating system memory page. Decommit operates only on whole pages of this size.
+std::size_t GetPageSize () noexcept;
+
+// Returns physical memory of given range to operating system, but keeps address space. Range must consist of
+// whole operating system pages. Memory is committed again on first touch, its content is undefined after that.
+void Decommit (void *address, std::size_t size) noexcept;
+
+// Allocates memory block, which address is multiple of given power of two alignment.
+void *AllocateAligned (std::size_t size, std::size_t alignment) noexcept;
+
+// Frees block, allocated by AllocateAligned.
+void FreeAligned (void *address) noexcept;
+
+// Maps block directly from operating system, which address is multiple of given power of two alignment. Unlike
+// AllocateAligned, alignment padding does not fragment allocator heap and it is returned to operating system.
+void *AllocateAlignedPages (std::size_t size, std::size_t alignment) noexcept;
+
+// Frees block, allocated by AllocateAlignedPages. Size must be the same as during allocation.
+void FreeAlignedPages (void *address, std::size_t size) noexcept;
+}
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <thread>
+
+#include <Memory/ShardedUnorderedPool.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
+#if defined (_WIN32)
+#include <windows.h>
+#elif defined (__linux__)
+#include <sched.h>
+#endif
+
+namespace Memory
+{
+ShardedUnorderedTrivialPool::ShardedUnorderedTrivialPool (
+    SizeType pageCapacity, SizeType chunkSize, SizeType shardCount) noexcept
+    : pageMutex_ (),
+      fields_ (UntypedPoolFields::ForEmptyPool (pageCapacity, chunkSize)),
+      shardCount_ (shardCount ? shardCount : std::max (std::thread::hardware_concurrency (), 1u)),
+      shards_ (new Shard[shardCount_])
+{
+    assert (pageCapacity > 0u);
+    assert (chunkSize >= sizeof (uintptr_t));
+}
+
+ShardedUnorderedTrivialPool::~ShardedUnorderedTrivialPool () noexcept
+{
+    Clean ();
+}
+
+void *ShardedUnorderedTrivialPool::Acquire () noexcept
+{
+    return AcquireFromShard (GetCurrentShardIndex ());
+}
+
+void ShardedUnorderedTrivialPool::Free (void *entry) noexcept
+{
+    FreeToShard (entry, GetCurrentShardIndex ());
+}
+
+void *ShardedUnorderedTrivialPool::AcquireFromShard (SizeType shardIndex) noexcept
+{
+    assert (shardIndex < shardCount_);
+    Shard &shard = shards_[shardIndex];
+    std::lock_guard <std::mutex> shardLock (shard.mutex_);
+
+    if (!shard.topFreeChunk_)
+    {
+        // Chunks, spilled by other shards, are taken before new page is constructed.
+        std::lock_guard <std::mutex> pageLock (pageMutex_);
+        shard.topFreeChunk_ = PoolDetail::DetachFreeChunks (
+            fields_, fields_.chunkSize_, fields_.pageCapacity_, shard.freeCount_);
+    }
+
+    ChunkPointer chunk = shard.topFreeChunk_;
+    shard.topFreeChunk_ = PoolDetail::NextFreeChunk (chunk);
+    --shard.freeCount_;
+    return chunk;
+}
+
+void ShardedUnorderedTrivialPool::FreeToShard (void *entry, SizeType shardIndex) noexcept
+{
+    assert (entry);
+    assert (shardIndex < shardCount_);
+    Shard &shard = shards_[shardIndex];
+    std::lock_guard <std::mutex> shardLock (shard.mutex_);
+
+    PoolDetail::SetNextFreeChunk (entry, shard.topFreeChunk_);
+    shard.topFreeChunk_ = entry;
+
+    // Limit is twice bigger than spilled count, so thread, that frees and acquires near the limit, rarely spills.
+    if (++shard.freeCount_ > fields_.pageCapacity_ * 2u)
+    {
+        SpillFreeChunks (shard);
+    }
+}
+
+void ShardedUnorderedTrivialPool::Clean () noexcept
+{
+    std::lock_guard <std::mutex> pageLock (pageMutex_);
+    PoolDetail::TrivialClean (fields_, fields_.chunkSize_);
+
+    for (SizeType shardIndex = 0u; shardIndex < shardCount_; ++shardIndex)
+    {
+        shards_[shardIndex].topFreeChunk_ = nullptr;
+        shards_[shardIndex].freeCount_ = 0u;
+    }
+}
+
+SizeType ShardedUnorderedTrivialPool::GetPageCount () const
+{
+    std::lock_guard <std::mutex> pageLock (pageMutex_);
+    return fields_.pageCount_;
+}
+
+SizeType ShardedUnorderedTrivialPool::GetPageCapacity () const
+{
+    return fields_.pageCapacity_;
+}
+
+SizeType ShardedUnorderedTrivialPool::GetShardCount () const
+{
+    return shardCount_;
+}
+
+SizeType ShardedUnorderedTrivialPool::GetCurrentCpu () noexcept
+{
+#if defined (_WIN32)
+    return static_cast <SizeType> (GetCurrentProcessorNumber ());
+#elif defined (__linux__)
+    // Recent glibc versions read CPU index from restartable sequence area, so this call does not enter kernel.
+    const int cpu = sched_getcpu ();
+    return cpu >= 0 ? static_cast <SizeType> (cpu) : 0u;
+#else
+    // There is no portable way to get current CPU, therefore threads are distributed by their ids.
+    return static_cast <SizeType> (std::hash <std::thread::id> {} (std::this_thread::get_id ()));
+#endif
+}
+
+SizeType ShardedUnorderedTrivialPool::GetCurrentShardIndex () const noexcept
+{
+    return GetCurrentCpu () % shardCount_;
+}
+
+void ShardedUnorderedTrivialPool::SpillFreeChunks (Shard &shard) noexcept
+{
+    // List is cut outside of page lock, so other shards wait only for splice.
+    ChunkPointer top = shard.topFreeChunk_;
+    ChunkPointer last = top;
+
+    for (SizeType index = 1u; index < fields_.pageCapacity_; ++index)
+    {
+        last = PoolDetail::NextFreeChunk (last);
+    }
+
+    shard.topFreeChunk_ = PoolDetail::NextFreeChunk (last);
+    shard.freeCount_ -= fields_.pageCapacity_;
+
+    std::lock_guard <std::mutex> pageLock (pageMutex_);
+    PoolDetail::AttachFreeChunks (fields_, top, last);
+}
+}
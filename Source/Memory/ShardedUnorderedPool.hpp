@@ -0,0 +1,73 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+#include <Memory/Private/Commons.hpp>
+
+namespace Memory
+{
+// Thread safe version of UnorderedTrivialPool, that keeps separate free list for every shard and selects shard
+// by CPU, on which calling thread is running. Therefore memory overhead depends on core count instead of thread
+// count, and threads rarely contend for the same shard lock. Entries may be freed on any thread: freed chunk
+// goes to the shard of current CPU. Shard keeps no more than two pages worth of free chunks, excess is returned
+// to shared free list, from which empty shards take chunks before new page is constructed. Therefore producer
+// and consumer threads do not grow the pool. Pages are released only by Clean.
+class ShardedUnorderedTrivialPool
+{
+public:
+    using ValueType = void;
+
+    // If shard count is zero, one shard per hardware thread is created.
+    ShardedUnorderedTrivialPool (SizeType pageCapacity, SizeType chunkSize, SizeType shardCount = 0u) noexcept;
+
+    ShardedUnorderedTrivialPool (const ShardedUnorderedTrivialPool &other) = delete;
+
+    ShardedUnorderedTrivialPool (ShardedUnorderedTrivialPool &&other) = delete;
+
+    ~ShardedUnorderedTrivialPool () noexcept;
+
+    void *Acquire () noexcept;
+
+    void Free (void *entry) noexcept;
+
+    // Same as Acquire and Free above, but shard is selected by caller, for example, by job system worker index.
+    void *AcquireFromShard (SizeType shardIndex) noexcept;
+
+    void FreeToShard (void *entry, SizeType shardIndex) noexcept;
+
+    // Frees all pages. Must not be called concurrently with other operations.
+    void Clean () noexcept;
+
+    SizeType GetPageCount () const;
+
+    SizeType GetPageCapacity () const;
+
+    SizeType GetShardCount () const;
+
+private:
+    // Shards are aligned to cache line size to avoid false sharing between CPUs.
+    struct alignas (64) Shard
+    {
+        std::mutex mutex_;
+        ChunkPointer topFreeChunk_ = nullptr;
+        SizeType freeCount_ = 0u;
+    };
+
+    // Returns index of CPU, on which calling thread is running, or any stable per thread value if it is unknown.
+    static SizeType GetCurrentCpu () noexcept;
+
+    SizeType GetCurrentShardIndex () const noexcept;
+
+    // Moves one page worth of free chunks from given shard to shared free list. Shard must be locked.
+    void SpillFreeChunks (Shard &shard) noexcept;
+
+    // Pages and spilled free chunks are shared by all shards: shard takes one page worth of chunks, when its free
+    // list is empty.
+    mutable std::mutex pageMutex_;
+    UntypedPoolFields fields_;
+
+    SizeType shardCount_;
+    std::unique_ptr <Shard []> shards_;
+};
+}
@@ -0,0 +1,390 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+#include <Memory/Private/Commons.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+#include <Memory/Private/VirtualMemory.hpp>
+
+namespace Memory
+{
+// Pool, that stores entries as structure of arrays: every page contains separate array for every field, therefore
+// systems can process one field of all page entries with SIMD instructions. Entries are referenced by stable slot
+// indices. Pages are linked through usual page header and counted in BasePoolFields, page table maps slot indices
+// to pages. Fields are not stored in free slots, so every page keeps stack of its free slot indices and bitmap of
+// its live slots before field arrays. Pages with free slots are linked into separate list, like in compact pool.
+template <typename... Fields>
+class SoaPool
+{
+    static_assert (sizeof... (Fields) > 0u, "SoA pool must have at least one field!");
+    static_assert ((std::is_trivial_v <Fields> && ...), "SoA pool fields must be trivial types!");
+
+public:
+    template <std::size_t FieldIndex>
+    using FieldType = std::tuple_element_t <FieldIndex, std::tuple <Fields...>>;
+
+    // Every field array is aligned to this value, so it can be processed with aligned vector loads.
+    static constexpr std::size_t FIELD_ALIGNMENT = 64u;
+
+    // Returned by Acquire when page or page table can not be allocated.
+    static constexpr SizeType INVALID_SLOT = UINT32_MAX;
+
+    explicit SoaPool (SizeType pageCapacity) noexcept;
+
+    SoaPool (const SoaPool &other) = delete;
+
+    SoaPool (SoaPool &&other) noexcept;
+
+    ~SoaPool () noexcept;
+
+    // Returns slot index, that is equal to page index multiplied by page capacity plus index inside page,
+    // or INVALID_SLOT if allocation failed. Field values of acquired slot are undefined.
+    SizeType Acquire () noexcept;
+
+    void Free (SizeType slot) noexcept;
+
+    template <std::size_t FieldIndex>
+    FieldType <FieldIndex> &Get (SizeType slot) noexcept;
+
+    template <std::size_t FieldIndex>
+    const FieldType <FieldIndex> &Get (SizeType slot) const noexcept;
+
+    // Returns array of given field with page capacity elements. Values in free slots are undefined,
+    // therefore loops over field arrays should check live mask or tolerate garbage in free slots.
+    template <std::size_t FieldIndex>
+    FieldType <FieldIndex> *GetPageField (SizeType pageIndex) noexcept;
+
+    template <std::size_t FieldIndex>
+    const FieldType <FieldIndex> *GetPageField (SizeType pageIndex) const noexcept;
+
+    // Returns bitmap of live page slots: bit of slot with index I inside page is bit I % 64 of word I / 64.
+    const uint64_t *GetPageLiveMask (SizeType pageIndex) const noexcept;
+
+    SizeType GetPageLiveCount (SizeType pageIndex) const noexcept;
+
+    bool IsLive (SizeType slot) const noexcept;
+
+    void Clean () noexcept;
+
+    SizeType GetPageCount () const;
+
+    SizeType GetPageCapacity () const;
+
+private:
+    static constexpr std::size_t FIELD_COUNT = sizeof... (Fields);
+
+    static constexpr SizeType NO_PAGE = UINT32_MAX;
+
+    // Placed after page header, page header itself links all pool pages.
+    struct PageState
+    {
+        SizeType liveCount_;
+        SizeType freeStackSize_;
+
+        // Slots after initialized count were never acquired, so they are not in free stack.
+        SizeType initializedCount_;
+        SizeType nextFreePage_;
+    };
+
+    static constexpr std::size_t LIVE_MASK_OFFSET = PageDetail::PAGE_HEADER_SIZE + sizeof (PageState);
+    static_assert (LIVE_MASK_OFFSET % alignof (uint64_t) == 0u);
+
+    // Last element is page size.
+    using FieldOffsets = std::array <std::size_t, FIELD_COUNT + 1u>;
+
+    static std::size_t CalculateFreeStackOffset (SizeType pageCapacity) noexcept;
+
+    static FieldOffsets CalculateFieldOffsets (SizeType pageCapacity) noexcept;
+
+    PageState *GetPageState (SizeType pageIndex) const noexcept;
+
+    uint64_t *GetLiveMask (SizeType pageIndex) const noexcept;
+
+    SizeType *GetFreeStack (SizeType pageIndex) const noexcept;
+
+    uint8_t *GetFieldAddress (SizeType pageIndex, std::size_t fieldIndex) const noexcept;
+
+    // Returns false if page or grown page table can not be allocated, pool is left unchanged in this case.
+    bool ConstructPage () noexcept;
+
+    BasePoolFields fields_;
+    FieldOffsets fieldOffsets_;
+    std::size_t freeStackOffset_;
+
+    // Page table is grown only when new page is constructed, therefore its allocation errors are reported by Acquire.
+    PagePointer *pageTable_;
+    SizeType pageTableCapacity_;
+    SizeType topFreePage_;
+};
+
+template <typename... Fields>
+SoaPool <Fields...>::SoaPool (SizeType pageCapacity) noexcept
+    : fields_ (BasePoolFields::ForEmptyPool (pageCapacity)),
+      fieldOffsets_ (CalculateFieldOffsets (pageCapacity)),
+      freeStackOffset_ (CalculateFreeStackOffset (pageCapacity)),
+      pageTable_ (nullptr),
+      pageTableCapacity_ (0u),
+      topFreePage_ (NO_PAGE)
+{
+    assert (pageCapacity > 0u);
+}
+
+template <typename... Fields>
+SoaPool <Fields...>::SoaPool (SoaPool &&other) noexcept
+    : fields_ (other.fields_),
+      fieldOffsets_ (other.fieldOffsets_),
+      freeStackOffset_ (other.freeStackOffset_),
+      pageTable_ (other.pageTable_),
+      pageTableCapacity_ (other.pageTableCapacity_),
+      topFreePage_ (other.topFreePage_)
+{
+    other.fields_ = BasePoolFields::ForEmptyPool (fields_.pageCapacity_);
+    other.pageTable_ = nullptr;
+    other.pageTableCapacity_ = 0u;
+    other.topFreePage_ = NO_PAGE;
+}
+
+template <typename... Fields>
+SoaPool <Fields...>::~SoaPool () noexcept
+{
+    Clean ();
+}
+
+template <typename... Fields>
+SizeType SoaPool <Fields...>::Acquire () noexcept
+{
+    if (topFreePage_ == NO_PAGE && !ConstructPage ())
+    {
+        return INVALID_SLOT;
+    }
+
+    const SizeType pageIndex = topFreePage_;
+    PageState *state = GetPageState (pageIndex);
+    SizeType index;
+
+    if (state->freeStackSize_ > 0u)
+    {
+        index = GetFreeStack (pageIndex)[--state->freeStackSize_];
+    }
+    else
+    {
+        assert (state->initializedCount_ < fields_.pageCapacity_);
+        index = state->initializedCount_++;
+    }
+
+    uint64_t &maskWord = GetLiveMask (pageIndex)[index / 64u];
+    assert (!(maskWord & (uint64_t {1u} << index % 64u)));
+    maskWord |= uint64_t {1u} << index % 64u;
+
+    if (++state->liveCount_ == fields_.pageCapacity_)
+    {
+        topFreePage_ = state->nextFreePage_;
+        state->nextFreePage_ = NO_PAGE;
+    }
+
+    return pageIndex * fields_.pageCapacity_ + index;
+}
+
+template <typename... Fields>
+void SoaPool <Fields...>::Free (SizeType slot) noexcept
+{
+    assert (IsLive (slot));
+    const SizeType pageIndex = slot / fields_.pageCapacity_;
+    const SizeType index = slot % fields_.pageCapacity_;
+    PageState *state = GetPageState (pageIndex);
+
+    GetLiveMask (pageIndex)[index / 64u] &= ~(uint64_t {1u} << index % 64u);
+    GetFreeStack (pageIndex)[state->freeStackSize_++] = index;
+
+    // Full page is not in free pages list, so it is linked back after its first slot is freed.
+    if (state->liveCount_-- == fields_.pageCapacity_)
+    {
+        state->nextFreePage_ = topFreePage_;
+        topFreePage_ = pageIndex;
+    }
+}
+
+template <typename... Fields>
+template <std::size_t FieldIndex>
+typename SoaPool <Fields...>::template FieldType <FieldIndex> &SoaPool <Fields...>::Get (SizeType slot) noexcept
+{
+    return GetPageField <FieldIndex> (slot / fields_.pageCapacity_)[slot % fields_.pageCapacity_];
+}
+
+template <typename... Fields>
+template <std::size_t FieldIndex>
+const typename SoaPool <Fields...>::template FieldType <FieldIndex> &SoaPool <Fields...>::Get (
+    SizeType slot) const noexcept
+{
+    return GetPageField <FieldIndex> (slot / fields_.pageCapacity_)[slot % fields_.pageCapacity_];
+}
+
+template <typename... Fields>
+template <std::size_t FieldIndex>
+typename SoaPool <Fields...>::template FieldType <FieldIndex> *SoaPool <Fields...>::GetPageField (
+    SizeType pageIndex) noexcept
+{
+    static_assert (FieldIndex < FIELD_COUNT);
+    return reinterpret_cast <FieldType <FieldIndex> *> (GetFieldAddress (pageIndex, FieldIndex));
+}
+
+template <typename... Fields>
+template <std::size_t FieldIndex>
+const typename SoaPool <Fields...>::template FieldType <FieldIndex> *SoaPool <Fields...>::GetPageField (
+    SizeType pageIndex) const noexcept
+{
+    static_assert (FieldIndex < FIELD_COUNT);
+    return reinterpret_cast <const FieldType <FieldIndex> *> (GetFieldAddress (pageIndex, FieldIndex));
+}
+
+template <typename... Fields>
+const uint64_t *SoaPool <Fields...>::GetPageLiveMask (SizeType pageIndex) const noexcept
+{
+    return GetLiveMask (pageIndex);
+}
+
+template <typename... Fields>
+SizeType SoaPool <Fields...>::GetPageLiveCount (SizeType pageIndex) const noexcept
+{
+    return GetPageState (pageIndex)->liveCount_;
+}
+
+template <typename... Fields>
+bool SoaPool <Fields...>::IsLive (SizeType slot) const noexcept
+{
+    const SizeType pageIndex = slot / fields_.pageCapacity_;
+    const SizeType index = slot % fields_.pageCapacity_;
+    return pageIndex < fields_.pageCount_ && (GetLiveMask (pageIndex)[index / 64u] >> index % 64u & 1u);
+}
+
+template <typename... Fields>
+void SoaPool <Fields...>::Clean () noexcept
+{
+    PagePointer page = fields_.topPage_;
+    while (page)
+    {
+        PagePointer next = PageDetail::NextPage (page);
+        VirtualMemory::FreeAligned (page);
+        page = next;
+    }
+
+    free (pageTable_);
+    fields_ = BasePoolFields::ForEmptyPool (fields_.pageCapacity_);
+    pageTable_ = nullptr;
+    pageTableCapacity_ = 0u;
+    topFreePage_ = NO_PAGE;
+}
+
+template <typename... Fields>
+SizeType SoaPool <Fields...>::GetPageCount () const
+{
+    return fields_.pageCount_;
+}
+
+template <typename... Fields>
+SizeType SoaPool <Fields...>::GetPageCapacity () const
+{
+    return fields_.pageCapacity_;
+}
+
+template <typename... Fields>
+std::size_t SoaPool <Fields...>::CalculateFreeStackOffset (SizeType pageCapacity) noexcept
+{
+    return LIVE_MASK_OFFSET + (static_cast <std::size_t> (pageCapacity) + 63u) / 64u * sizeof (uint64_t);
+}
+
+template <typename... Fields>
+typename SoaPool <Fields...>::FieldOffsets SoaPool <Fields...>::CalculateFieldOffsets (SizeType pageCapacity) noexcept
+{
+    constexpr std::array <std::size_t, FIELD_COUNT> fieldSizes {sizeof (Fields)...};
+    FieldOffsets offsets {};
+    std::size_t offset = CalculateFreeStackOffset (pageCapacity) + pageCapacity * sizeof (SizeType);
+
+    for (std::size_t fieldIndex = 0u; fieldIndex < FIELD_COUNT; ++fieldIndex)
+    {
+        offset = (offset + FIELD_ALIGNMENT - 1u) / FIELD_ALIGNMENT * FIELD_ALIGNMENT;
+        offsets[fieldIndex] = offset;
+        offset += fieldSizes[fieldIndex] * pageCapacity;
+    }
+
+    offsets[FIELD_COUNT] = offset;
+    return offsets;
+}
+
+template <typename... Fields>
+typename SoaPool <Fields...>::PageState *SoaPool <Fields...>::GetPageState (SizeType pageIndex) const noexcept
+{
+    assert (pageIndex < fields_.pageCount_);
+    return reinterpret_cast <PageState *> (static_cast <uint8_t *> (pageTable_[pageIndex]) +
+                                           PageDetail::PAGE_HEADER_SIZE);
+}
+
+template <typename... Fields>
+uint64_t *SoaPool <Fields...>::GetLiveMask (SizeType pageIndex) const noexcept
+{
+    assert (pageIndex < fields_.pageCount_);
+    return reinterpret_cast <uint64_t *> (static_cast <uint8_t *> (pageTable_[pageIndex]) + LIVE_MASK_OFFSET);
+}
+
+template <typename... Fields>
+SizeType *SoaPool <Fields...>::GetFreeStack (SizeType pageIndex) const noexcept
+{
+    assert (pageIndex < fields_.pageCount_);
+    return reinterpret_cast <SizeType *> (static_cast <uint8_t *> (pageTable_[pageIndex]) + freeStackOffset_);
+}
+
+template <typename... Fields>
+uint8_t *SoaPool <Fields...>::GetFieldAddress (SizeType pageIndex, std::size_t fieldIndex) const noexcept
+{
+    assert (pageIndex < fields_.pageCount_);
+    return static_cast <uint8_t *> (pageTable_[pageIndex]) + fieldOffsets_[fieldIndex];
+}
+
+template <typename... Fields>
+bool SoaPool <Fields...>::ConstructPage () noexcept
+{
+    // Slot index of the last page slot must be less than INVALID_SLOT.
+    if ((static_cast <uint64_t> (fields_.pageCount_) + 1u) * fields_.pageCapacity_ > INVALID_SLOT)
+    {
+        return false;
+    }
+
+    if (fields_.pageCount_ == pageTableCapacity_)
+    {
+        const SizeType newCapacity = pageTableCapacity_ > 0u ? pageTableCapacity_ * 2u : 8u;
+        void *newTable = realloc (pageTable_, newCapacity * sizeof (PagePointer));
+
+        if (!newTable)
+        {
+            return false;
+        }
+
+        pageTable_ = static_cast <PagePointer *> (newTable);
+        pageTableCapacity_ = newCapacity;
+    }
+
+    PagePointer page = VirtualMemory::AllocateAligned (fieldOffsets_[FIELD_COUNT], FIELD_ALIGNMENT);
+    if (!page)
+    {
+        return false;
+    }
+
+    const std::size_t liveMaskSize = freeStackOffset_ - LIVE_MASK_OFFSET;
+    memset (static_cast <uint8_t *> (page) + LIVE_MASK_OFFSET, 0, liveMaskSize);
+    PageDetail::SetNextPage (page, fields_.topPage_);
+    fields_.topPage_ = page;
+
+    const SizeType pageIndex = fields_.pageCount_++;
+    pageTable_[pageIndex] = page;
+    *GetPageState (pageIndex) = {0u, 0u, 0u, topFreePage_};
+    topFreePage_ = pageIndex;
+    return true;
+}
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+
+#include <Memory/TypedUnorderedPool.hpp>
+#include <Memory/Private/Commons.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
+namespace Memory
+{
+// Pool with compile time capacity, that stores entries inside pool object and therefore never allocates memory.
+// Pool object can be placed into static or thread local storage or into any user provided buffer. Chunks are
+// acquired in order until capacity is reached for the first time, after that only freed chunks are reused.
+template <
+    typename Entry,
+    SizeType Capacity,
+    PoolEntryOperation <Entry> Constructor = EntryDefaultConstructor,
+    PoolEntryOperation <Entry> Destructor = EntryDefaultDestructor>
+class StaticTypedPool
+{
+    static_assert (Capacity > 0u);
+
+public:
+    using ValueType = Entry;
+
+    StaticTypedPool () noexcept;
+
+    // Free list points into pool object, so it can not be moved.
+    StaticTypedPool (const StaticTypedPool &other) = delete;
+
+    StaticTypedPool (StaticTypedPool &&other) = delete;
+
+    ~StaticTypedPool () noexcept;
+
+    // Pool must not be full.
+    Entry *Acquire () noexcept;
+
+    // Returns nullptr if there is no free chunks.
+    Entry *TryAcquire () noexcept;
+
+    void Free (Entry *entry) noexcept;
+
+    // Destructs all used entries and makes all chunks free.
+    void Clean () noexcept;
+
+    SizeType GetUsedCount () const noexcept;
+
+    static constexpr SizeType GetCapacity () noexcept;
+
+private:
+    // Chunk must be able to hold free list link.
+    using Chunk = std::aligned_storage_t <std::max (sizeof (Entry), sizeof (uintptr_t)),
+                                          std::max (alignof (Entry), alignof (uintptr_t))>;
+
+    Chunk chunks_[Capacity];
+    ChunkPointer topFreeChunk_;
+
+    // Chunks after this count were never acquired, so they are not linked into free list.
+    SizeType initializedCount_;
+    SizeType usedCount_;
+};
+
+template <typename Entry, SizeType Capacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+StaticTypedPool <Entry, Capacity, Constructor, Destructor>::StaticTypedPool () noexcept
+    : topFreeChunk_ (nullptr),
+      initializedCount_ (0u),
+      usedCount_ (0u)
+{
+}
+
+template <typename Entry, SizeType Capacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+StaticTypedPool <Entry, Capacity, Constructor, Destructor>::~StaticTypedPool () noexcept
+{
+    Clean ();
+}
+
+template <typename Entry, SizeType Capacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+Entry *StaticTypedPool <Entry, Capacity, Constructor, Destructor>::Acquire () noexcept
+{
+    Entry *entry = TryAcquire ();
+    assert (entry);
+    return entry;
+}
+
+template <typename Entry, SizeType Capacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+Entry *StaticTypedPool <Entry, Capacity, Constructor, Destructor>::TryAcquire () noexcept
+{
+    ChunkPointer chunk;
+    if (topFreeChunk_)
+    {
+        chunk = topFreeChunk_;
+        topFreeChunk_ = PoolDetail::NextFreeChunk (chunk);
+    }
+    else if (initializedCount_ < Capacity)
+    {
+        chunk = &chunks_[initializedCount_++];
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    ++usedCount_;
+    auto *entry = static_cast <Entry *> (chunk);
+    Constructor (entry);
+    return entry;
+}
+
+template <typename Entry, SizeType Capacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+void StaticTypedPool <Entry, Capacity, Constructor, Destructor>::Free (Entry *entry) noexcept
+{
+    assert (entry);
+    assert (reinterpret_cast <Chunk *> (entry) >= chunks_ &&
+            reinterpret_cast <Chunk *> (entry) < chunks_ + initializedCount_);
+
+    if constexpr (!IsEntryDestructionTrivial <Entry, Destructor> ())
+    {
+        Destructor (entry);
+    }
+
+    PoolDetail::SetNextFreeChunk (entry, topFreeChunk_);
+    topFreeChunk_ = entry;
+    --usedCount_;
+}
+
+template <typename Entry, SizeType Capacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+void StaticTypedPool <Entry, Capacity, Constructor, Destructor>::Clean () noexcept
+{
+    if constexpr (!IsEntryDestructionTrivial <Entry, Destructor> ())
+    {
+        // When free list is sorted by address, used chunks can be found in one pass without additional memory.
+        ChunkPointer nextFreeChunk = PoolDetail::SortFreeChunks (topFreeChunk_);
+        for (SizeType index = 0u; index < initializedCount_; ++index)
+        {
+            if (&chunks_[index] == nextFreeChunk)
+            {
+                nextFreeChunk = PoolDetail::NextFreeChunk (nextFreeChunk);
+            }
+            else
+            {
+                Destructor (reinterpret_cast <Entry *> (&chunks_[index]));
+            }
+        }
+
+        assert (!nextFreeChunk);
+    }
+
+    topFreeChunk_ = nullptr;
+    initializedCount_ = 0u;
+    usedCount_ = 0u;
+}
+
+template <typename Entry, SizeType Capacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+SizeType StaticTypedPool <Entry, Capacity, Constructor, Destructor>::GetUsedCount () const noexcept
+{
+    return usedCount_;
+}
+
+template <typename Entry, SizeType Capacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+constexpr SizeType StaticTypedPool <Entry, Capacity, Constructor, Destructor>::GetCapacity () noexcept
+{
+    return Capacity;
+}
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <Memory/TypedUnorderedPool.hpp>
+#include <Memory/Private/Commons.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
+namespace Memory
+{
+// Version of TypedUnorderedPool with compile time page capacity. Page geometry is constant, therefore Acquire and
+// Free are inlined: they work with free list directly and call PoolDetail only when new page must be constructed.
+// Chunk lookup uses constant page size, so compiler replaces divisions with shifts for power of two sizes.
+// Page release policy, incremental shrink and owner lookup are not supported, because they require tracking
+// in PoolDetail::Acquire and PoolDetail::Free.
+template <
+    typename Entry,
+    SizeType PageCapacity,
+    PoolEntryOperation <Entry> Constructor = EntryDefaultConstructor,
+    PoolEntryOperation <Entry> Destructor = EntryDefaultDestructor>
+class TypedFixedUnorderedPool
+{
+    static_assert (sizeof (Entry) >= sizeof (uintptr_t),
+                   "Entry type size must be at equal or greater than pointer size!");
+
+    static_assert (PageCapacity > 0u);
+
+public:
+    using ValueType = Entry;
+
+    // Page size in bytes, page header included.
+    static constexpr std::size_t PAGE_SIZE = PageDetail::PAGE_HEADER_SIZE + PageCapacity * sizeof (Entry);
+
+    TypedFixedUnorderedPool () noexcept;
+
+    TypedFixedUnorderedPool (const TypedFixedUnorderedPool &other) = delete;
+
+    TypedFixedUnorderedPool (TypedFixedUnorderedPool &&other) noexcept;
+
+    ~TypedFixedUnorderedPool () noexcept;
+
+    Entry *Acquire () noexcept;
+
+    // Acquires entry and constructs it from given arguments instead of calling Constructor.
+    // Follows TypedUnorderedPool::Emplace: chunk is freed without Destructor call if construction throws.
+    template <typename... Args>
+    Entry *Emplace (Args &&... args);
+
+    void Free (Entry *entry) noexcept;
+
+    void Reserve (SizeType entryCount, bool prefault = false) noexcept;
+
+    void Shrink () noexcept;
+
+    void Clean () noexcept;
+
+    // Returns true if entry belongs to one of the pool pages.
+    bool IsFrom (const Entry *entry) const noexcept;
+
+    SizeType GetPageCount () const;
+
+    static constexpr SizeType GetPageCapacity () noexcept;
+
+private:
+    static bool IsFromPage (PagePointer page, const Entry *entry) noexcept;
+
+    Entry *AcquireUninitialized () noexcept;
+
+    BasePoolFields fields_;
+};
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::TypedFixedUnorderedPool () noexcept
+    : fields_ (BasePoolFields::ForEmptyPool (PageCapacity))
+{
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::TypedFixedUnorderedPool (
+    TypedFixedUnorderedPool &&other) noexcept
+    : fields_ (other.fields_)
+{
+    other.fields_ = BasePoolFields::ForEmptyPool (PageCapacity);
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::~TypedFixedUnorderedPool () noexcept
+{
+    Clean ();
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+Entry *TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::Acquire () noexcept
+{
+    Entry *entry = AcquireUninitialized ();
+    Constructor (entry);
+    return entry;
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+template <typename... Args>
+Entry *TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::Emplace (Args &&... args)
+{
+    Entry *entry = AcquireUninitialized ();
+    try
+    {
+        return EmplaceEntry <Entry> (entry, std::forward <Args> (args)...);
+    }
+    catch (...)
+    {
+        PoolDetail::SetNextFreeChunk (entry, fields_.topFreeChunk_);
+        fields_.topFreeChunk_ = entry;
+        throw;
+    }
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+void TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::Free (Entry *entry) noexcept
+{
+    assert (entry);
+    assert (IsFrom (entry));
+
+    if constexpr (!IsEntryDestructionTrivial <Entry, Destructor> ())
+    {
+        Destructor (entry);
+    }
+
+    PoolDetail::SetNextFreeChunk (entry, fields_.topFreeChunk_);
+    fields_.topFreeChunk_ = entry;
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+void TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::Reserve (SizeType entryCount,
+                                                                                      bool prefault) noexcept
+{
+    PoolDetail::Reserve (fields_, sizeof (Entry), entryCount, prefault);
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+void TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::Shrink () noexcept
+{
+    PoolDetail::Shrink (fields_, sizeof (Entry));
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+void TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::Clean () noexcept
+{
+    if constexpr (IsEntryDestructionTrivial <Entry, Destructor> ())
+    {
+        PoolDetail::TrivialClean (fields_, sizeof (Entry));
+    }
+    else
+    {
+        PoolDetail::NonTrivialClean (
+            fields_, sizeof (Entry),
+            [] (void *entry)
+            {
+                Destructor (static_cast <Entry *> (entry));
+            });
+    }
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+bool TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::IsFrom (
+    const Entry *entry) const noexcept
+{
+    for (PagePointer page = fields_.topPage_; page; page = PageDetail::NextPage (page))
+    {
+        if (IsFromPage (page, entry))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+SizeType TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::GetPageCount () const
+{
+    return fields_.pageCount_;
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+constexpr SizeType TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::GetPageCapacity () noexcept
+{
+    return PageCapacity;
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+bool TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::IsFromPage (
+    PagePointer page, const Entry *entry) noexcept
+{
+    // Unsigned offset turns range check into one comparison, modulo by constant is folded into mask or multiply.
+    const uintptr_t offset = reinterpret_cast <uintptr_t> (entry) - reinterpret_cast <uintptr_t> (page) -
+                             PageDetail::PAGE_HEADER_SIZE;
+    return offset < PageCapacity * sizeof (Entry) && offset % sizeof (Entry) == 0u;
+}
+
+template <typename Entry, SizeType PageCapacity, PoolEntryOperation <Entry> Constructor,
+          PoolEntryOperation <Entry> Destructor>
+Entry *TypedFixedUnorderedPool <Entry, PageCapacity, Constructor, Destructor>::AcquireUninitialized () noexcept
+{
+    if (ChunkPointer chunk = fields_.topFreeChunk_)
+    {
+        fields_.topFreeChunk_ = PoolDetail::NextFreeChunk (chunk);
+        return static_cast <Entry *> (chunk);
+    }
+
+    // Slow path: PoolDetail constructs new page with constant capacity and links its chunks.
+    auto *entry = static_cast <Entry *> (PoolDetail::Acquire (fields_, sizeof (Entry)));
+    assert (entry);
+    return entry;
+}
+}
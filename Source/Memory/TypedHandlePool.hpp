@@ -0,0 +1,364 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <Memory/TypedUnorderedPool.hpp>
+#include <Memory/Private/Commons.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
+namespace Memory
+{
+// Compact 32-bit reference to handle pool entry. Consists of generation (highest 8 bits), page
+// index and slot index inside page. Count of slot index bits depends on pool page capacity.
+struct PoolHandle
+{
+    static constexpr uint32_t GENERATION_BITS = 8u;
+    static constexpr uint32_t GENERATION_SHIFT = 32u - GENERATION_BITS;
+
+    // Generation of issued handle is always odd, therefore zero handle is never returned by pools.
+    static constexpr PoolHandle Invalid ();
+
+    bool operator == (const PoolHandle &other) const noexcept;
+
+    bool operator != (const PoolHandle &other) const noexcept;
+
+    uint32_t value_ = 0u;
+};
+
+// Pool, that references entries by generational handles instead of pointers. Handles are resolved
+// in O(1) through page table and resolution of handles to already freed entries returns nullptr.
+// Generation is incremented on both Acquire and Free, so used slots have odd generations and free slots have even
+// ones. Generation has only 8 bits, therefore stale handle detection is not guaranteed after 127 reuses of one slot.
+template <
+    typename Entry,
+    PoolEntryOperation <Entry> Constructor = EntryDefaultConstructor,
+    PoolEntryOperation <Entry> Destructor = EntryDefaultDestructor>
+class TypedHandlePool
+{
+    static_assert (PoolHandle::GENERATION_BITS <= 8u);
+
+public:
+    using ValueType = Entry;
+
+    // Page capacity must be power of two, because page index and slot index are packed into one handle.
+    explicit TypedHandlePool (SizeType pageCapacity) noexcept;
+
+    // Page capacity is rounded down to power of two, so page may be smaller than requested size.
+    explicit TypedHandlePool (PageSize pageSize) noexcept;
+
+    TypedHandlePool (const TypedHandlePool &other) = delete;
+
+    TypedHandlePool (TypedHandlePool &&other) noexcept;
+
+    ~TypedHandlePool () noexcept;
+
+    PoolHandle Acquire () noexcept;
+
+    Entry *Resolve (PoolHandle handle) const noexcept;
+
+    // Stale, already freed and forged handles are ignored.
+    void Free (PoolHandle handle) noexcept;
+
+    void Reserve (SizeType entryCount, bool prefault = false) noexcept;
+
+    // Slot generations are kept, so handles, issued before Clean, are not resolved to entries on recreated pages.
+    void Clean () noexcept;
+
+    SizeType GetPageCount () const;
+
+    SizeType GetPageCapacity () const;
+
+    // Maximum count of pages, that can be addressed by handles with current page capacity.
+    SizeType GetMaxPageCount () const;
+
+private:
+    // Slot handle is stored after entry storage, so it is not overwritten by free list link.
+    struct Slot
+    {
+        std::aligned_storage_t <std::max (sizeof (Entry), sizeof (uintptr_t)),
+                                std::max (alignof (Entry), alignof (uintptr_t))> storage_;
+        PoolHandle handle_;
+    };
+
+    static SizeType CalculateSlotBits (SizeType pageCapacity) noexcept;
+
+    static SizeType CalculatePowerOfTwoCapacity (PageSize pageSize) noexcept;
+
+    // Increments generation of given handle, zero generation follows the last one.
+    static PoolHandle NextGeneration (PoolHandle handle) noexcept;
+
+    Slot *GetSlot (PoolHandle handle) const noexcept;
+
+    void RegisterNewPage (PagePointer page) noexcept;
+
+    // Destructs used entries and frees all pages, but does not save generations.
+    void ReleasePages () noexcept;
+
+    BasePoolFields fields_;
+    SizeType slotBits_;
+    std::vector <PagePointer> pageTable_;
+
+    // Generations of slots of pages, that were freed by Clean, indexed by page index and slot index.
+    std::vector <uint8_t> savedGenerations_;
+};
+
+constexpr PoolHandle PoolHandle::Invalid ()
+{
+    return {0u};
+}
+
+inline bool PoolHandle::operator == (const PoolHandle &other) const noexcept
+{
+    return value_ == other.value_;
+}
+
+inline bool PoolHandle::operator != (const PoolHandle &other) const noexcept
+{
+    return !(*this == other);
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+TypedHandlePool <Entry, Constructor, Destructor>::TypedHandlePool (SizeType pageCapacity) noexcept
+    : fields_ (BasePoolFields::ForEmptyPool (pageCapacity)),
+      slotBits_ (CalculateSlotBits (pageCapacity)),
+      pageTable_ (),
+      savedGenerations_ ()
+{
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+TypedHandlePool <Entry, Constructor, Destructor>::TypedHandlePool (PageSize pageSize) noexcept
+    : TypedHandlePool (CalculatePowerOfTwoCapacity (pageSize))
+{
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+TypedHandlePool <Entry, Constructor, Destructor>::TypedHandlePool (TypedHandlePool &&other) noexcept
+    : fields_ (other.fields_),
+      slotBits_ (other.slotBits_),
+      pageTable_ (std::move (other.pageTable_)),
+      savedGenerations_ (std::move (other.savedGenerations_))
+{
+    other.fields_ = BasePoolFields::ForEmptyPool (fields_.pageCapacity_);
+    other.pageTable_.clear ();
+    other.savedGenerations_.clear ();
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+TypedHandlePool <Entry, Constructor, Destructor>::~TypedHandlePool () noexcept
+{
+    ReleasePages ();
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+PoolHandle TypedHandlePool <Entry, Constructor, Destructor>::Acquire () noexcept
+{
+    // If there is no free chunks, PoolDetail::Acquire will construct new page and push it to the top.
+    const SizeType pageCountBefore = fields_.pageCount_;
+    auto *slot = reinterpret_cast <Slot *> (PoolDetail::Acquire (fields_, sizeof (Slot)));
+    assert (slot);
+
+    if (fields_.pageCount_ != pageCountBefore)
+    {
+        RegisterNewPage (fields_.topPage_);
+    }
+
+    slot->handle_ = NextGeneration (slot->handle_);
+    Constructor (reinterpret_cast <Entry *> (&slot->storage_));
+    return slot->handle_;
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+Entry *TypedHandlePool <Entry, Constructor, Destructor>::Resolve (PoolHandle handle) const noexcept
+{
+    Slot *slot = GetSlot (handle);
+    return slot ? reinterpret_cast <Entry *> (&slot->storage_) : nullptr;
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedHandlePool <Entry, Constructor, Destructor>::Free (PoolHandle handle) noexcept
+{
+    Slot *slot = GetSlot (handle);
+    if (!slot)
+    {
+        return;
+    }
+
+    if constexpr (!IsEntryDestructionTrivial <Entry, Destructor> ())
+    {
+        Destructor (reinterpret_cast <Entry *> (&slot->storage_));
+    }
+
+    // Even generation marks slot as free, so neither this handle nor forged one with new generation is resolved.
+    slot->handle_ = NextGeneration (handle);
+    PoolDetail::Free (fields_, slot, sizeof (Slot));
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedHandlePool <Entry, Constructor, Destructor>::Reserve (SizeType entryCount, bool prefault) noexcept
+{
+    const SizeType pageCountBefore = fields_.pageCount_;
+    PoolDetail::Reserve (fields_, sizeof (Slot), entryCount, prefault);
+
+    // New pages are pushed to the top of pages list.
+    PagePointer page = fields_.topPage_;
+    for (SizeType newPageIndex = pageCountBefore; newPageIndex < fields_.pageCount_; ++newPageIndex)
+    {
+        RegisterNewPage (page);
+        page = PageDetail::NextPage (page);
+    }
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedHandlePool <Entry, Constructor, Destructor>::Clean () noexcept
+{
+    const SizeType pageCapacity = fields_.pageCapacity_;
+    if (savedGenerations_.size () < pageTable_.size () * pageCapacity)
+    {
+        savedGenerations_.resize (pageTable_.size () * pageCapacity);
+    }
+
+    for (std::size_t pageIndex = 0u; pageIndex < pageTable_.size (); ++pageIndex)
+    {
+        auto *slot = static_cast <Slot *> (PageDetail::GetFirstChunk (pageTable_[pageIndex]));
+        for (SizeType slotIndex = 0u; slotIndex < pageCapacity; ++slotIndex, ++slot)
+        {
+            // Used slots are freed by Clean, therefore their generations are incremented like in Free.
+            PoolHandle handle = slot->handle_;
+            if (handle.value_ >> PoolHandle::GENERATION_SHIFT & 1u)
+            {
+                handle = NextGeneration (handle);
+            }
+
+            savedGenerations_[pageIndex * pageCapacity + slotIndex] =
+                static_cast <uint8_t> (handle.value_ >> PoolHandle::GENERATION_SHIFT);
+        }
+    }
+
+    ReleasePages ();
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedHandlePool <Entry, Constructor, Destructor>::ReleasePages () noexcept
+{
+    if constexpr (IsEntryDestructionTrivial <Entry, Destructor> ())
+    {
+        PoolDetail::TrivialClean (fields_, sizeof (Slot));
+    }
+    else
+    {
+        PoolDetail::NonTrivialClean (
+            fields_, sizeof (Slot),
+            [] (void *slot)
+            {
+                Destructor (reinterpret_cast <Entry *> (&static_cast <Slot *> (slot)->storage_));
+            });
+    }
+
+    pageTable_.clear ();
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+SizeType TypedHandlePool <Entry, Constructor, Destructor>::GetPageCount () const
+{
+    return fields_.pageCount_;
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+SizeType TypedHandlePool <Entry, Constructor, Destructor>::GetPageCapacity () const
+{
+    return fields_.pageCapacity_;
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+SizeType TypedHandlePool <Entry, Constructor, Destructor>::GetMaxPageCount () const
+{
+    return 1u << (PoolHandle::GENERATION_SHIFT - slotBits_);
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+SizeType TypedHandlePool <Entry, Constructor, Destructor>::CalculateSlotBits (SizeType pageCapacity) noexcept
+{
+    assert (pageCapacity > 0u);
+    assert ((pageCapacity & (pageCapacity - 1u)) == 0u);
+
+    SizeType bits = 0u;
+    while ((1u << bits) < pageCapacity)
+    {
+        ++bits;
+    }
+
+    // At least one bit must be left for page index.
+    assert (bits < PoolHandle::GENERATION_SHIFT);
+    return bits;
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+SizeType TypedHandlePool <Entry, Constructor, Destructor>::CalculatePowerOfTwoCapacity (PageSize pageSize) noexcept
+{
+    SizeType capacity = PageDetail::CalculatePageCapacity (pageSize, sizeof (Slot));
+    // Clear lower bits until only the highest one is left.
+    while (capacity & (capacity - 1u))
+    {
+        capacity &= capacity - 1u;
+    }
+
+    return capacity;
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+PoolHandle TypedHandlePool <Entry, Constructor, Destructor>::NextGeneration (PoolHandle handle) noexcept
+{
+    constexpr uint32_t GENERATION_MASK = ((1u << PoolHandle::GENERATION_BITS) - 1u) << PoolHandle::GENERATION_SHIFT;
+    const uint32_t generation = (handle.value_ + (1u << PoolHandle::GENERATION_SHIFT)) & GENERATION_MASK;
+    return {(handle.value_ & ~GENERATION_MASK) | generation};
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+typename TypedHandlePool <Entry, Constructor, Destructor>::Slot *
+TypedHandlePool <Entry, Constructor, Destructor>::GetSlot (PoolHandle handle) const noexcept
+{
+    // Handles with even generation are never issued, so forged handle can not resolve free slot.
+    if (!(handle.value_ >> PoolHandle::GENERATION_SHIFT & 1u))
+    {
+        return nullptr;
+    }
+
+    const uint32_t slotIndex = handle.value_ & ((1u << slotBits_) - 1u);
+    const uint32_t pageIndex =
+        (handle.value_ >> slotBits_) & ((1u << (PoolHandle::GENERATION_SHIFT - slotBits_)) - 1u);
+
+    if (pageIndex >= pageTable_.size ())
+    {
+        return nullptr;
+    }
+
+    auto *slot = static_cast <Slot *> (PageDetail::GetFirstChunk (pageTable_[pageIndex])) + slotIndex;
+    // Slot generation is incremented when slot is freed, therefore stale handles are not resolved.
+    return slot->handle_ == handle ? slot : nullptr;
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedHandlePool <Entry, Constructor, Destructor>::RegisterNewPage (PagePointer page) noexcept
+{
+    assert (pageTable_.size () < GetMaxPageCount ());
+    assert (page);
+
+    const auto pageIndex = static_cast <uint32_t> (pageTable_.size ());
+    pageTable_.push_back (page);
+    auto *slot = static_cast <Slot *> (PageDetail::GetFirstChunk (page));
+
+    for (uint32_t slotIndex = 0u; slotIndex < fields_.pageCapacity_; ++slotIndex, ++slot)
+    {
+        // Page with this index may be recreated after Clean, in this case slot continues its saved generation.
+        const std::size_t generationIndex = static_cast <std::size_t> (pageIndex) * fields_.pageCapacity_ + slotIndex;
+        const uint32_t generation =
+            generationIndex < savedGenerations_.size () ? savedGenerations_[generationIndex] : 0u;
+        slot->handle_.value_ = (generation << PoolHandle::GENERATION_SHIFT) | (pageIndex << slotBits_) | slotIndex;
+    }
+}
+}
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <cassert>
+#include <new>
 #include <type_traits>
+#include <utility>
 
+#include <Memory/ParallelExecutor.hpp>
 #include <Memory/Private/Commons.hpp>
 #include <Memory/Private/PoolDetail.hpp>
 
@@ -20,6 +23,8 @@ public:
 
     explicit TypedUnorderedTrivialPool (SizeType pageCapacity) noexcept;
 
+    explicit TypedUnorderedTrivialPool (PageSize pageSize) noexcept;
+
     TypedUnorderedTrivialPool (const TypedUnorderedTrivialPool &other) = delete;
 
     TypedUnorderedTrivialPool (TypedUnorderedTrivialPool &&other) noexcept;
@@ -28,17 +33,56 @@ public:
 
     Entry *Acquire () noexcept;
 
+    // Acquires entry and constructs it from given arguments through EmplaceEntry.
+    // If construction throws, acquired chunk is freed and exception is rethrown.
+    template <typename... Args>
+    Entry *Emplace (Args &&... args);
+
     void Free (Entry *entry) noexcept;
 
+    void Reserve (SizeType entryCount, bool prefault = false) noexcept;
+
+    void SetReleasedPageMode (ReleasedPageMode mode) noexcept;
+
+    void SetMaxPageCapacity (SizeType maxPageCapacity) noexcept;
+
+    void SetPageDepot (PageDepot *depot) noexcept;
+
+    void SetPageProvisioner (PageProvisioner *provisioner) noexcept;
+
+    // Stores pool in page owner headers, so entries can be freed by address only, for example, by PoolUniquePtr.
+    // Must be called for empty pool. Returns false if entry is too big, see PoolDetail::SetPageOwner.
+    bool EnableOwnerLookup () noexcept;
+
     void Shrink () noexcept;
 
+    // Incremental version of Shrink, that processes no more than budget free chunks or pages per call.
+    // Returns true when shrink pass is finished. See PoolDetail::ShrinkStep for details.
+    bool ShrinkStep (SizeType budget) noexcept;
+
+    // Pool releases empty pages automatically according to this policy. See PageReleasePolicy for details.
+    void SetPageReleasePolicy (const PageReleasePolicy &policy) noexcept;
+
+    // Moves entries from sparse pages to free chunks of denser pages using move construction and releases
+    // emptied pages. Works incrementally like ShrinkStep, returns true when pass is finished.
+    bool Compact (SizeType budget) noexcept;
+
+    // Same as Compact above, but relocates entries using given relocator. Relocator is called as
+    // relocator (Entry *source, Entry *target) and must construct target and destruct source.
+    template <typename Relocator>
+    bool Compact (SizeType budget, const Relocator &relocator) noexcept;
+
     void Clean () noexcept;
 
     SizeType GetPageCount () const;
 
     SizeType GetPageCapacity () const;
 
+    SizeType GetMaxPageCapacity () const;
+
 private:
+    static void FreeOwned (void *pool, void *entry) noexcept;
+
     BasePoolFields fields_;
 };
 
@@ -51,6 +95,19 @@ void EntryDefaultConstructor (Entry *entry) noexcept;
 template <typename Entry>
 void EntryDefaultDestructor (Entry *entry) noexcept;
 
+template <typename Entry>
+void EntryDefaultRelocator (Entry *source, Entry *target) noexcept;
+
+// Constructs entry in given chunk through constructor, selected by arguments, if there is one, otherwise through
+// brace initialization, so aggregates can be emplaced from their field values.
+template <typename Entry, typename... Args>
+Entry *EmplaceEntry (void *chunk, Args &&... args);
+
+// Entry destruction is no-op if default destructor is used for trivially destructible type, therefore
+// pools can skip destructor calls on Free and release pages without searching for used chunks on Clean.
+template <typename Entry, PoolEntryOperation <Entry> Destructor>
+constexpr bool IsEntryDestructionTrivial () noexcept;
+
 template <
     typename Entry,
     PoolEntryOperation <Entry> Constructor = EntryDefaultConstructor,
@@ -75,6 +132,8 @@ public:
 
     explicit TypedUnorderedPool (SizeType pageCapacity) noexcept;
 
+    explicit TypedUnorderedPool (PageSize pageSize) noexcept;
+
     TypedUnorderedPool (const TypedUnorderedPool &other) = delete;
 
     TypedUnorderedPool (TypedUnorderedPool &&other) noexcept;
@@ -83,17 +142,64 @@ public:
 
     Entry *Acquire () noexcept;
 
+    // Acquires entry and constructs it from given arguments through EmplaceEntry instead of calling Constructor,
+    // so entry is not constructed twice when it is initialized with non default values.
+    // If construction throws, acquired chunk is freed without calling Destructor and exception is rethrown.
+    template <typename... Args>
+    Entry *Emplace (Args &&... args);
+
+    // Acquires entry without calling Constructor. Caller must construct entry before it is freed or
+    // pool is cleaned, because destructor is called for every used entry.
+    Entry *AcquireUninitialized () noexcept;
+
     void Free (Entry *entry) noexcept;
 
+    void Reserve (SizeType entryCount, bool prefault = false) noexcept;
+
+    void SetReleasedPageMode (ReleasedPageMode mode) noexcept;
+
+    void SetMaxPageCapacity (SizeType maxPageCapacity) noexcept;
+
+    void SetPageDepot (PageDepot *depot) noexcept;
+
+    void SetPageProvisioner (PageProvisioner *provisioner) noexcept;
+
+    // Stores pool in page owner headers, so entries can be freed by address only, for example, by PoolUniquePtr.
+    // Must be called for empty pool. Returns false if entry is too big, see PoolDetail::SetPageOwner.
+    bool EnableOwnerLookup () noexcept;
+
     void Shrink () noexcept;
 
+    // Incremental version of Shrink, that processes no more than budget free chunks or pages per call.
+    // Returns true when shrink pass is finished. See PoolDetail::ShrinkStep for details.
+    bool ShrinkStep (SizeType budget) noexcept;
+
+    // Pool releases empty pages automatically according to this policy. See PageReleasePolicy for details.
+    void SetPageReleasePolicy (const PageReleasePolicy &policy) noexcept;
+
+    // Moves entries from sparse pages to free chunks of denser pages using move construction and releases
+    // emptied pages. Works incrementally like ShrinkStep, returns true when pass is finished.
+    bool Compact (SizeType budget) noexcept;
+
+    // Same as Compact above, but relocates entries using given relocator. Relocator is called as
+    // relocator (Entry *source, Entry *target) and must construct target and destruct source.
+    template <typename Relocator>
+    bool Compact (SizeType budget, const Relocator &relocator) noexcept;
+
     void Clean () noexcept;
 
+    // Destructs entries of disjoint page ranges (pagesPerTask pages each) in parallel using given executor.
+    void Clean (const ParallelExecutor &executor, SizeType pagesPerTask = 4u) noexcept;
+
     SizeType GetPageCount () const;
 
     SizeType GetPageCapacity () const;
 
+    SizeType GetMaxPageCapacity () const;
+
 private:
+    static void FreeOwned (void *pool, void *entry) noexcept;
+
     BasePoolFields fields_;
 };
 
@@ -112,17 +218,59 @@ void EntryDefaultDestructor (Entry *entry) noexcept
     entry->~Entry ();
 }
 
+template <typename Entry, PoolEntryOperation <Entry> Destructor>
+constexpr bool IsEntryDestructionTrivial () noexcept
+{
+    // Cast is required because of bug in some GCC versions, which forbids such equality checks.
+    return std::is_trivially_destructible_v <Entry> &&
+           Destructor == static_cast <PoolEntryOperation <Entry>> (EntryDefaultDestructor <Entry>);
+}
+
+template <typename Entry>
+void EntryDefaultRelocator (Entry *source, Entry *target) noexcept
+{
+    assert (source);
+    assert (target);
+    new (target) Entry (std::move (*source));
+    source->~Entry ();
+}
+
+template <typename Entry, typename... Args>
+Entry *EmplaceEntry (void *chunk, Args &&... args)
+{
+    assert (chunk);
+    if constexpr (std::is_constructible_v <Entry, Args...>)
+    {
+        return new (chunk) Entry (std::forward <Args> (args)...);
+    }
+    else
+    {
+        return new (chunk) Entry {std::forward <Args> (args)...};
+    }
+}
+
 template <typename Entry>
 TypedUnorderedTrivialPool <Entry>::TypedUnorderedTrivialPool (SizeType pageCapacity) noexcept
     : fields_ (BasePoolFields::ForEmptyPool (pageCapacity))
 {
 }
 
+template <typename Entry>
+TypedUnorderedTrivialPool <Entry>::TypedUnorderedTrivialPool (PageSize pageSize) noexcept
+    : TypedUnorderedTrivialPool (PageDetail::CalculatePageCapacity (pageSize, sizeof (Entry)))
+{
+}
+
 template <typename Entry>
 TypedUnorderedTrivialPool <Entry>::TypedUnorderedTrivialPool (TypedUnorderedTrivialPool &&other) noexcept
     : fields_ (other.fields_)
 {
     other.fields_ = BasePoolFields::ForEmptyPool (fields_.pageCapacity_);
+    if (fields_.pageOwner_.pool_)
+    {
+        // Page headers still point to moved out pool.
+        PoolDetail::SetPageOwner (fields_, sizeof (Entry), {this, FreeOwned});
+    }
 }
 
 template <typename Entry>
@@ -139,18 +287,100 @@ Entry *TypedUnorderedTrivialPool <Entry>::Acquire () noexcept
     return entry;
 }
 
+template <typename Entry>
+template <typename... Args>
+Entry *TypedUnorderedTrivialPool <Entry>::Emplace (Args &&... args)
+{
+    Entry *entry = Acquire ();
+    try
+    {
+        return EmplaceEntry <Entry> (entry, std::forward <Args> (args)...);
+    }
+    catch (...)
+    {
+        Free (entry);
+        throw;
+    }
+}
+
 template <typename Entry>
 void TypedUnorderedTrivialPool <Entry>::Free (Entry *entry) noexcept
 {
     PoolDetail::Free (fields_, entry, sizeof (Entry));
 }
 
+template <typename Entry>
+void TypedUnorderedTrivialPool <Entry>::Reserve (SizeType entryCount, bool prefault) noexcept
+{
+    PoolDetail::Reserve (fields_, sizeof (Entry), entryCount, prefault);
+}
+
+template <typename Entry>
+void TypedUnorderedTrivialPool <Entry>::SetReleasedPageMode (ReleasedPageMode mode) noexcept
+{
+    PoolDetail::SetReleasedPageMode (fields_, mode);
+}
+
+template <typename Entry>
+void TypedUnorderedTrivialPool <Entry>::SetMaxPageCapacity (SizeType maxPageCapacity) noexcept
+{
+    PoolDetail::SetMaxPageCapacity (fields_, sizeof (Entry), maxPageCapacity);
+}
+
+template <typename Entry>
+void TypedUnorderedTrivialPool <Entry>::SetPageDepot (PageDepot *depot) noexcept
+{
+    PoolDetail::SetPageDepot (fields_, depot);
+}
+
+template <typename Entry>
+void TypedUnorderedTrivialPool <Entry>::SetPageProvisioner (PageProvisioner *provisioner) noexcept
+{
+    PoolDetail::SetPageProvisioner (fields_, sizeof (Entry), provisioner);
+}
+
+template <typename Entry>
+bool TypedUnorderedTrivialPool <Entry>::EnableOwnerLookup () noexcept
+{
+    return PoolDetail::SetPageOwner (fields_, sizeof (Entry), {this, FreeOwned});
+}
+
 template <typename Entry>
 void TypedUnorderedTrivialPool <Entry>::Shrink () noexcept
 {
     PoolDetail::Shrink (fields_, sizeof (Entry));
 }
 
+template <typename Entry>
+bool TypedUnorderedTrivialPool <Entry>::ShrinkStep (SizeType budget) noexcept
+{
+    return PoolDetail::ShrinkStep (fields_, sizeof (Entry), budget);
+}
+
+template <typename Entry>
+void TypedUnorderedTrivialPool <Entry>::SetPageReleasePolicy (const PageReleasePolicy &policy) noexcept
+{
+    PoolDetail::SetPageReleasePolicy (fields_, sizeof (Entry), policy);
+}
+
+template <typename Entry>
+bool TypedUnorderedTrivialPool <Entry>::Compact (SizeType budget) noexcept
+{
+    return Compact (budget, EntryDefaultRelocator <Entry>);
+}
+
+template <typename Entry>
+template <typename Relocator>
+bool TypedUnorderedTrivialPool <Entry>::Compact (SizeType budget, const Relocator &relocator) noexcept
+{
+    return PoolDetail::Compact (
+        fields_, sizeof (Entry), budget,
+        [&relocator] (void *source, void *target)
+        {
+            relocator (reinterpret_cast <Entry *> (source), reinterpret_cast <Entry *> (target));
+        });
+}
+
 template <typename Entry>
 void TypedUnorderedTrivialPool <Entry>::Clean () noexcept
 {
@@ -169,9 +399,27 @@ SizeType TypedUnorderedTrivialPool <Entry>::GetPageCapacity () const
     return fields_.pageCapacity_;
 }
 
+template <typename Entry>
+SizeType TypedUnorderedTrivialPool <Entry>::GetMaxPageCapacity () const
+{
+    return fields_.maxPageCapacity_;
+}
+
+template <typename Entry>
+void TypedUnorderedTrivialPool <Entry>::FreeOwned (void *pool, void *entry) noexcept
+{
+    static_cast <TypedUnorderedTrivialPool <Entry> *> (pool)->Free (static_cast <Entry *> (entry));
+}
+
 template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
 TypedUnorderedPool <Entry, Constructor, Destructor>::TypedUnorderedPool (SizeType pageCapacity) noexcept
-    : fields_ {nullptr, nullptr, 0u, pageCapacity}
+    : fields_ (BasePoolFields::ForEmptyPool (pageCapacity))
+{
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+TypedUnorderedPool <Entry, Constructor, Destructor>::TypedUnorderedPool (PageSize pageSize) noexcept
+    : TypedUnorderedPool (PageDetail::CalculatePageCapacity (pageSize, sizeof (Entry)))
 {
 }
 
@@ -180,6 +428,11 @@ TypedUnorderedPool <Entry, Constructor, Destructor>::TypedUnorderedPool (TypedUn
     : fields_ (other.fields_)
 {
     other.fields_ = BasePoolFields::ForEmptyPool (fields_.pageCapacity_);
+    if (fields_.pageOwner_.pool_)
+    {
+        // Page headers still point to moved out pool.
+        PoolDetail::SetPageOwner (fields_, sizeof (Entry), {this, FreeOwned});
+    }
 }
 
 template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
@@ -190,10 +443,34 @@ TypedUnorderedPool <Entry, Constructor, Destructor>::~TypedUnorderedPool () noex
 
 template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
 Entry *TypedUnorderedPool <Entry, Constructor, Destructor>::Acquire () noexcept
+{
+    Entry *entry = AcquireUninitialized ();
+    Constructor (entry);
+    return entry;
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+template <typename... Args>
+Entry *TypedUnorderedPool <Entry, Constructor, Destructor>::Emplace (Args &&... args)
+{
+    Entry *entry = AcquireUninitialized ();
+    try
+    {
+        return EmplaceEntry <Entry> (entry, std::forward <Args> (args)...);
+    }
+    catch (...)
+    {
+        // Entry was not constructed, therefore chunk is freed directly, without Destructor call.
+        PoolDetail::Free (fields_, entry, sizeof (Entry));
+        throw;
+    }
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+Entry *TypedUnorderedPool <Entry, Constructor, Destructor>::AcquireUninitialized () noexcept
 {
     auto *entry = reinterpret_cast <Entry *> (PoolDetail::Acquire (fields_, sizeof (Entry)));
     assert (entry);
-    Constructor (entry);
     return entry;
 }
 
@@ -202,10 +479,51 @@ void TypedUnorderedPool <Entry, Constructor, Destructor>::Free (Entry *entry) no
 {
     assert (entry);
     PoolDetail::AssertFromPool (fields_, entry, sizeof (Entry));
-    Destructor (entry);
+
+    if constexpr (!IsEntryDestructionTrivial <Entry, Destructor> ())
+    {
+        Destructor (entry);
+    }
+
     PoolDetail::Free (fields_, entry, sizeof (Entry));
 }
 
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedUnorderedPool <Entry, Constructor, Destructor>::Reserve (SizeType entryCount, bool prefault) noexcept
+{
+    PoolDetail::Reserve (fields_, sizeof (Entry), entryCount, prefault);
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedUnorderedPool <Entry, Constructor, Destructor>::SetReleasedPageMode (ReleasedPageMode mode) noexcept
+{
+    PoolDetail::SetReleasedPageMode (fields_, mode);
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedUnorderedPool <Entry, Constructor, Destructor>::SetMaxPageCapacity (SizeType maxPageCapacity) noexcept
+{
+    PoolDetail::SetMaxPageCapacity (fields_, sizeof (Entry), maxPageCapacity);
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedUnorderedPool <Entry, Constructor, Destructor>::SetPageDepot (PageDepot *depot) noexcept
+{
+    PoolDetail::SetPageDepot (fields_, depot);
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedUnorderedPool <Entry, Constructor, Destructor>::SetPageProvisioner (PageProvisioner *provisioner) noexcept
+{
+    PoolDetail::SetPageProvisioner (fields_, sizeof (Entry), provisioner);
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+bool TypedUnorderedPool <Entry, Constructor, Destructor>::EnableOwnerLookup () noexcept
+{
+    return PoolDetail::SetPageOwner (fields_, sizeof (Entry), {this, FreeOwned});
+}
+
 template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
 void TypedUnorderedPool <Entry, Constructor, Destructor>::Shrink () noexcept
 {
@@ -213,16 +531,75 @@ void TypedUnorderedPool <Entry, Constructor, Destructor>::Shrink () noexcept
 }
 
 template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
-void TypedUnorderedPool <Entry, Constructor, Destructor>::Clean () noexcept
+bool TypedUnorderedPool <Entry, Constructor, Destructor>::ShrinkStep (SizeType budget) noexcept
+{
+    return PoolDetail::ShrinkStep (fields_, sizeof (Entry), budget);
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedUnorderedPool <Entry, Constructor, Destructor>::SetPageReleasePolicy (
+    const PageReleasePolicy &policy) noexcept
+{
+    PoolDetail::SetPageReleasePolicy (fields_, sizeof (Entry), policy);
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+bool TypedUnorderedPool <Entry, Constructor, Destructor>::Compact (SizeType budget) noexcept
 {
-    PoolDetail::NonTrivialClean (
-        fields_, sizeof (Entry),
-        [] (void *entry)
+    return Compact (budget, EntryDefaultRelocator <Entry>);
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+template <typename Relocator>
+bool TypedUnorderedPool <Entry, Constructor, Destructor>::Compact (SizeType budget,
+                                                                   const Relocator &relocator) noexcept
+{
+    return PoolDetail::Compact (
+        fields_, sizeof (Entry), budget,
+        [&relocator] (void *source, void *target)
         {
-            Destructor (reinterpret_cast <Entry *> (entry));
+            relocator (reinterpret_cast <Entry *> (source), reinterpret_cast <Entry *> (target));
         });
 }
 
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedUnorderedPool <Entry, Constructor, Destructor>::Clean () noexcept
+{
+    if constexpr (IsEntryDestructionTrivial <Entry, Destructor> ())
+    {
+        PoolDetail::TrivialClean (fields_, sizeof (Entry));
+    }
+    else
+    {
+        PoolDetail::NonTrivialClean (
+            fields_, sizeof (Entry),
+            [] (void *entry)
+            {
+                Destructor (reinterpret_cast <Entry *> (entry));
+            });
+    }
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedUnorderedPool <Entry, Constructor, Destructor>::Clean (const ParallelExecutor &executor,
+                                                                 SizeType pagesPerTask) noexcept
+{
+    if constexpr (IsEntryDestructionTrivial <Entry, Destructor> ())
+    {
+        PoolDetail::TrivialClean (fields_, sizeof (Entry));
+    }
+    else
+    {
+        PoolDetail::NonTrivialClean (
+            fields_, sizeof (Entry),
+            [] (void *entry)
+            {
+                Destructor (reinterpret_cast <Entry *> (entry));
+            },
+            executor, pagesPerTask);
+    }
+}
+
 template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
 SizeType TypedUnorderedPool <Entry, Constructor, Destructor>::GetPageCount () const
 {
@@ -234,4 +611,16 @@ SizeType TypedUnorderedPool <Entry, Constructor, Destructor>::GetPageCapacity ()
 {
     return fields_.pageCapacity_;
 }
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+SizeType TypedUnorderedPool <Entry, Constructor, Destructor>::GetMaxPageCapacity () const
+{
+    return fields_.maxPageCapacity_;
+}
+
+template <typename Entry, PoolEntryOperation <Entry> Constructor, PoolEntryOperation <Entry> Destructor>
+void TypedUnorderedPool <Entry, Constructor, Destructor>::FreeOwned (void *pool, void *entry) noexcept
+{
+    static_cast <TypedUnorderedPool <Entry, Constructor, Destructor> *> (pool)->Free (static_cast <Entry *> (entry));
+}
 }
\ No newline at end of file
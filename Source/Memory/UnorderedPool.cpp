@@ -1,4 +1,5 @@
 #include <cassert>
+#include <cstring>
 
 #include <Memory/UnorderedPool.hpp>
 #include <Memory/Private/PoolDetail.hpp>
@@ -10,10 +11,20 @@ UnorderedTrivialPool::UnorderedTrivialPool (SizeType pageCapacity, SizeType chun
 {
 }
 
+UnorderedTrivialPool::UnorderedTrivialPool (PageSize pageSize, SizeType chunkSize) noexcept
+    : UnorderedTrivialPool (PageDetail::CalculatePageCapacity (pageSize, chunkSize), chunkSize)
+{
+}
+
 UnorderedTrivialPool::UnorderedTrivialPool (UnorderedTrivialPool &&other) noexcept
     : fields_ (other.fields_)
 {
     other.fields_ = UntypedPoolFields::ForEmptyPool (fields_.pageCapacity_, fields_.chunkSize_);
+    if (fields_.pageOwner_.pool_)
+    {
+        // Page headers still point to moved out pool.
+        PoolDetail::SetPageOwner (fields_, fields_.chunkSize_, {this, FreeOwned});
+    }
 }
 
 UnorderedTrivialPool::~UnorderedTrivialPool () noexcept
@@ -33,11 +44,68 @@ void UnorderedTrivialPool::Free (void *entry) noexcept
     PoolDetail::Free (fields_, entry, fields_.chunkSize_);
 }
 
+void UnorderedTrivialPool::Reserve (SizeType entryCount, bool prefault) noexcept
+{
+    PoolDetail::Reserve (fields_, fields_.chunkSize_, entryCount, prefault);
+}
+
+void UnorderedTrivialPool::SetReleasedPageMode (ReleasedPageMode mode) noexcept
+{
+    PoolDetail::SetReleasedPageMode (fields_, mode);
+}
+
+void UnorderedTrivialPool::SetMaxPageCapacity (SizeType maxPageCapacity) noexcept
+{
+    PoolDetail::SetMaxPageCapacity (fields_, fields_.chunkSize_, maxPageCapacity);
+}
+
+void UnorderedTrivialPool::SetPageDepot (PageDepot *depot) noexcept
+{
+    PoolDetail::SetPageDepot (fields_, depot);
+}
+
+void UnorderedTrivialPool::SetPageProvisioner (PageProvisioner *provisioner) noexcept
+{
+    PoolDetail::SetPageProvisioner (fields_, fields_.chunkSize_, provisioner);
+}
+
+bool UnorderedTrivialPool::EnableOwnerLookup () noexcept
+{
+    return PoolDetail::SetPageOwner (fields_, fields_.chunkSize_, {this, FreeOwned});
+}
+
 void UnorderedTrivialPool::Shrink () noexcept
 {
     PoolDetail::Shrink (fields_, fields_.chunkSize_);
 }
 
+bool UnorderedTrivialPool::ShrinkStep (SizeType budget) noexcept
+{
+    return PoolDetail::ShrinkStep (fields_, fields_.chunkSize_, budget);
+}
+
+void UnorderedTrivialPool::SetPageReleasePolicy (const PageReleasePolicy &policy) noexcept
+{
+    PoolDetail::SetPageReleasePolicy (fields_, fields_.chunkSize_, policy);
+}
+
+bool UnorderedTrivialPool::Compact (SizeType budget) noexcept
+{
+    const SizeType chunkSize = fields_.chunkSize_;
+    return PoolDetail::Compact (
+        fields_, chunkSize, budget,
+        [chunkSize] (void *source, void *target)
+        {
+            memcpy (target, source, chunkSize);
+        });
+}
+
+bool UnorderedTrivialPool::Compact (SizeType budget, Relocator relocator) noexcept
+{
+    assert (relocator);
+    return PoolDetail::Compact (fields_, fields_.chunkSize_, budget, relocator);
+}
+
 void UnorderedTrivialPool::Clean () noexcept
 {
     PoolDetail::TrivialClean (fields_, fields_.chunkSize_);
@@ -53,9 +121,19 @@ SizeType UnorderedTrivialPool::GetPageCapacity () const
     return fields_.pageCapacity_;
 }
 
+SizeType UnorderedTrivialPool::GetMaxPageCapacity () const
+{
+    return fields_.maxPageCapacity_;
+}
+
+void UnorderedTrivialPool::FreeOwned (void *pool, void *entry) noexcept
+{
+    static_cast <UnorderedTrivialPool *> (pool)->Free (entry);
+}
+
 UnorderedPool::UnorderedPool (SizeType pageCapacity, SizeType chunkSize,
                               Constructor constructor, Destructor destructor) noexcept
-    : fields_ {nullptr, nullptr, 0u, pageCapacity, chunkSize},
+    : fields_ (UntypedPoolFields::ForEmptyPool (pageCapacity, chunkSize)),
       constructor_ (constructor),
       destructor_ (destructor)
 {
@@ -63,12 +141,23 @@ UnorderedPool::UnorderedPool (SizeType pageCapacity, SizeType chunkSize,
     assert (destructor_);
 }
 
+UnorderedPool::UnorderedPool (PageSize pageSize, SizeType chunkSize,
+                              Constructor constructor, Destructor destructor) noexcept
+    : UnorderedPool (PageDetail::CalculatePageCapacity (pageSize, chunkSize), chunkSize, constructor, destructor)
+{
+}
+
 UnorderedPool::UnorderedPool (UnorderedPool &&other) noexcept
     : fields_ (other.fields_),
       constructor_ (other.constructor_),
       destructor_ (other.destructor_)
 {
     other.fields_ = UntypedPoolFields::ForEmptyPool (fields_.pageCapacity_, fields_.chunkSize_);
+    if (fields_.pageOwner_.pool_)
+    {
+        // Page headers still point to moved out pool.
+        PoolDetail::SetPageOwner (fields_, fields_.chunkSize_, {this, FreeOwned});
+    }
     assert (constructor_);
     assert (destructor_);
 }
@@ -98,16 +187,67 @@ void UnorderedPool::Free (void *entry) noexcept
     PoolDetail::Free (fields_, entry, fields_.chunkSize_);
 }
 
+void UnorderedPool::Reserve (SizeType entryCount, bool prefault) noexcept
+{
+    PoolDetail::Reserve (fields_, fields_.chunkSize_, entryCount, prefault);
+}
+
+void UnorderedPool::SetReleasedPageMode (ReleasedPageMode mode) noexcept
+{
+    PoolDetail::SetReleasedPageMode (fields_, mode);
+}
+
+void UnorderedPool::SetMaxPageCapacity (SizeType maxPageCapacity) noexcept
+{
+    PoolDetail::SetMaxPageCapacity (fields_, fields_.chunkSize_, maxPageCapacity);
+}
+
+void UnorderedPool::SetPageDepot (PageDepot *depot) noexcept
+{
+    PoolDetail::SetPageDepot (fields_, depot);
+}
+
+void UnorderedPool::SetPageProvisioner (PageProvisioner *provisioner) noexcept
+{
+    PoolDetail::SetPageProvisioner (fields_, fields_.chunkSize_, provisioner);
+}
+
+bool UnorderedPool::EnableOwnerLookup () noexcept
+{
+    return PoolDetail::SetPageOwner (fields_, fields_.chunkSize_, {this, FreeOwned});
+}
+
 void UnorderedPool::Shrink () noexcept
 {
     PoolDetail::Shrink (fields_, fields_.chunkSize_);
 }
 
+bool UnorderedPool::ShrinkStep (SizeType budget) noexcept
+{
+    return PoolDetail::ShrinkStep (fields_, fields_.chunkSize_, budget);
+}
+
+void UnorderedPool::SetPageReleasePolicy (const PageReleasePolicy &policy) noexcept
+{
+    PoolDetail::SetPageReleasePolicy (fields_, fields_.chunkSize_, policy);
+}
+
+bool UnorderedPool::Compact (SizeType budget, Relocator relocator) noexcept
+{
+    assert (relocator);
+    return PoolDetail::Compact (fields_, fields_.chunkSize_, budget, relocator);
+}
+
 void UnorderedPool::Clean () noexcept
 {
     PoolDetail::NonTrivialClean (fields_, fields_.chunkSize_, destructor_);
 }
 
+void UnorderedPool::Clean (const ParallelExecutor &executor, SizeType pagesPerTask) noexcept
+{
+    PoolDetail::NonTrivialClean (fields_, fields_.chunkSize_, destructor_, executor, pagesPerTask);
+}
+
 SizeType UnorderedPool::GetPageCount () const
 {
     return fields_.pageCount_;
@@ -117,4 +257,14 @@ SizeType UnorderedPool::GetPageCapacity () const
 {
     return fields_.pageCapacity_;
 }
+
+SizeType UnorderedPool::GetMaxPageCapacity () const
+{
+    return fields_.maxPageCapacity_;
+}
+
+void UnorderedPool::FreeOwned (void *pool, void *entry) noexcept
+{
+    static_cast <UnorderedPool *> (pool)->Free (entry);
+}
 }
@@ -2,6 +2,7 @@
 
 #include <functional>
 
+#include <Memory/ParallelExecutor.hpp>
 #include <Memory/Private/Commons.hpp>
 
 namespace Memory
@@ -12,8 +13,13 @@ class UnorderedTrivialPool
 public:
     using ValueType = void;
 
+    // Moves source entry to target chunk. Source chunk is treated as free after relocation.
+    using Relocator = void (*) (void *source, void *target) noexcept;
+
     UnorderedTrivialPool (SizeType pageCapacity, SizeType chunkSize) noexcept;
 
+    UnorderedTrivialPool (PageSize pageSize, SizeType chunkSize) noexcept;
+
     UnorderedTrivialPool (const UnorderedTrivialPool &other) = delete;
 
     UnorderedTrivialPool (UnorderedTrivialPool &&other) noexcept;
@@ -24,15 +30,47 @@ public:
 
     void Free (void *entry) noexcept;
 
+    void Reserve (SizeType entryCount, bool prefault = false) noexcept;
+
+    void SetReleasedPageMode (ReleasedPageMode mode) noexcept;
+
+    void SetMaxPageCapacity (SizeType maxPageCapacity) noexcept;
+
+    void SetPageDepot (PageDepot *depot) noexcept;
+
+    void SetPageProvisioner (PageProvisioner *provisioner) noexcept;
+
+    // Stores pool in page owner headers, so entries can be freed by address only, for example, by FreeAny.
+    // Must be called for empty pool. Returns false if entry is too big, see PoolDetail::SetPageOwner.
+    bool EnableOwnerLookup () noexcept;
+
     void Shrink () noexcept;
 
+    // Incremental version of Shrink, that processes no more than budget free chunks or pages per call.
+    // Returns true when shrink pass is finished. See PoolDetail::ShrinkStep for details.
+    bool ShrinkStep (SizeType budget) noexcept;
+
+    // Pool releases empty pages automatically according to this policy. See PageReleasePolicy for details.
+    void SetPageReleasePolicy (const PageReleasePolicy &policy) noexcept;
+
+    // Moves entries from sparse pages to free chunks of denser pages using memcpy and releases emptied
+    // pages. Works incrementally like ShrinkStep, returns true when pass is finished.
+    bool Compact (SizeType budget) noexcept;
+
+    // Same as Compact above, but relocates entries using given relocator.
+    bool Compact (SizeType budget, Relocator relocator) noexcept;
+
     void Clean () noexcept;
 
     SizeType GetPageCount () const;
 
     SizeType GetPageCapacity () const;
 
+    SizeType GetMaxPageCapacity () const;
+
 private:
+    static void FreeOwned (void *pool, void *entry) noexcept;
+
     UntypedPoolFields fields_;
 };
 
@@ -43,10 +81,14 @@ public:
 
     using Constructor = void (*) (void *) noexcept;
     using Destructor = void (*) (void *) noexcept;
+    using Relocator = UnorderedTrivialPool::Relocator;
 
     UnorderedPool (SizeType pageCapacity, SizeType chunkSize,
                    Constructor constructor, Destructor destructor) noexcept;
 
+    UnorderedPool (PageSize pageSize, SizeType chunkSize,
+                   Constructor constructor, Destructor destructor) noexcept;
+
     UnorderedPool (const UnorderedPool &other) = delete;
 
     UnorderedPool (UnorderedPool &&other) noexcept;
@@ -57,15 +99,47 @@ public:
 
     void Free (void *entry) noexcept;
 
+    void Reserve (SizeType entryCount, bool prefault = false) noexcept;
+
+    void SetReleasedPageMode (ReleasedPageMode mode) noexcept;
+
+    void SetMaxPageCapacity (SizeType maxPageCapacity) noexcept;
+
+    void SetPageDepot (PageDepot *depot) noexcept;
+
+    void SetPageProvisioner (PageProvisioner *provisioner) noexcept;
+
+    // Stores pool in page owner headers, so entries can be freed by address only, for example, by FreeAny.
+    // Must be called for empty pool. Returns false if entry is too big, see PoolDetail::SetPageOwner.
+    bool EnableOwnerLookup () noexcept;
+
     void Shrink () noexcept;
 
+    // Incremental version of Shrink, that processes no more than budget free chunks or pages per call.
+    // Returns true when shrink pass is finished. See PoolDetail::ShrinkStep for details.
+    bool ShrinkStep (SizeType budget) noexcept;
+
+    // Pool releases empty pages automatically according to this policy. See PageReleasePolicy for details.
+    void SetPageReleasePolicy (const PageReleasePolicy &policy) noexcept;
+
+    // Moves entries from sparse pages to free chunks of denser pages using given relocator and releases
+    // emptied pages. Works incrementally like ShrinkStep, returns true when pass is finished.
+    bool Compact (SizeType budget, Relocator relocator) noexcept;
+
     void Clean () noexcept;
 
+    // Destructs entries of disjoint page ranges (pagesPerTask pages each) in parallel using given executor.
+    void Clean (const ParallelExecutor &executor, SizeType pagesPerTask = 4u) noexcept;
+
     SizeType GetPageCount () const;
 
     SizeType GetPageCapacity () const;
 
+    SizeType GetMaxPageCapacity () const;
+
 private:
+    static void FreeOwned (void *pool, void *entry) noexcept;
+
     UntypedPoolFields fields_;
     Constructor constructor_;
     Destructor destructor_;
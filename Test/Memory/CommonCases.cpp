@@ -11,3 +11,18 @@ bool NonTrivialData::operator != (const NonTrivialData &other) const
 {
     return !(other == *this);
 }
+
+bool TriviallyDestructibleData::operator == (const TriviallyDestructibleData &other) const
+{
+    return first_ == other.first_ &&
+           second_ == other.second_;
+}
+
+ThrowingData::ThrowingData (const char *text, bool shouldThrow)
+    : text_ (text)
+{
+    if (shouldThrow)
+    {
+        throw std::runtime_error ("Requested construction failure.");
+    }
+}
@@ -1,10 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
 
+#include <Memory/PageDepot.hpp>
+#include <Memory/PageProvisioner.hpp>
+#include <Memory/Private/Commons.hpp>
+#include <Memory/Private/PoolDetail.hpp>
+
 struct TrivialData
 {
     uint8_t a_;
@@ -29,6 +40,27 @@ struct NonTrivialData
 
 static_assert (!std::is_trivial_v <NonTrivialData>);
 
+struct TriviallyDestructibleData
+{
+    uint64_t first_ = 1u;
+    uint64_t second_ = 2u;
+
+    bool operator == (const TriviallyDestructibleData &other) const;
+};
+
+static_assert (!std::is_trivial_v <TriviallyDestructibleData>);
+static_assert (std::is_trivially_destructible_v <TriviallyDestructibleData>);
+
+// Constructor throws std::runtime_error if requested, used to check that Emplace does not leak chunks.
+struct ThrowingData
+{
+    ThrowingData () = default;
+
+    ThrowingData (const char *text, bool shouldThrow);
+
+    std::string text_;
+};
+
 template <typename Pool, typename ChunkEditor>
 void TestTrivialPoolAcquireFree (Pool &pool, const ChunkEditor &chunkEditor)
 {
@@ -61,6 +93,17 @@ void TestAnyPoolAcquirePageCount (Pool &pool)
     }
 }
 
+template <typename Pool>
+void TestAnyPoolPageSize (Pool &pool, std::size_t pageSize, std::size_t entrySize)
+{
+    // Page with headers must fit into requested size and there must be no space left for one more entry.
+    const std::size_t usedSize = Memory::PageDetail::PAGE_HEADER_SIZE + Memory::PageDetail::ALLOCATION_OVERHEAD +
+                                 pool.GetPageCapacity () * entrySize;
+    BOOST_REQUIRE (usedSize <= pageSize);
+    BOOST_REQUIRE (usedSize + entrySize > pageSize);
+    TestAnyPoolAcquirePageCount (pool);
+}
+
 template <typename Pool>
 void TestAnyPoolShrink (Pool &pool)
 {
@@ -111,4 +154,542 @@ void TestAnyPoolShrink (Pool &pool)
     BOOST_REQUIRE (pool.GetPageCount () == 0u);
 }
 
-// TODO: Test clean methods, check if destructors for non-trivial pools are called correctly.
+template <typename Pool>
+void TestAnyPoolShrinkStep (Pool &pool)
+{
+    BOOST_REQUIRE_MESSAGE (pool.GetPageCount () == 0u, "New empty pool must have 0 pages.");
+    std::vector <typename Pool::ValueType *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 3u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    // Free first page and half of second page before shrink pass.
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 3u / 2u; ++itemIndex)
+    {
+        pool.Free (values[itemIndex]);
+    }
+
+    // Free third page during shrink pass, like frame code would do.
+    for (uint32_t itemIndex = pool.GetPageCapacity () * 2u; itemIndex < values.size (); ++itemIndex)
+    {
+        pool.ShrinkStep (4u);
+        pool.Free (values[itemIndex]);
+    }
+
+    // Pass, that was in progress while third page was freed, may not see it as empty,
+    // therefore current pass is finished and then one more full pass is executed.
+    for (uint32_t passIndex = 0u; passIndex < 2u; ++passIndex)
+    {
+        uint32_t stepCount = 1u;
+        while (!pool.ShrinkStep (4u))
+        {
+            ++stepCount;
+            BOOST_REQUIRE (stepCount <= values.size ());
+        }
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+
+    // Acquire must return chunks, held by interrupted shrink pass, before constructing new pages.
+    BOOST_REQUIRE (!pool.ShrinkStep (1u));
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () / 2u; ++itemIndex)
+    {
+        pool.Acquire ();
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+    pool.Acquire ();
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+}
+
+// Budget limits every kind of work, so with budget 1 every call collects, sorts or checks one page, moves one free
+// chunk or walks one page during release, and pass takes exactly known count of calls.
+template <typename Pool>
+void TestAnyPoolShrinkStepBudget (Pool &pool)
+{
+    BOOST_REQUIRE_MESSAGE (pool.GetPageCount () == 0u, "New empty pool must have 0 pages.");
+    std::vector <typename Pool::ValueType *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 4u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    for (uint32_t itemIndex = 1u; itemIndex < values.size (); ++itemIndex)
+    {
+        pool.Free (values[itemIndex]);
+    }
+
+    const uint32_t pageCount = pool.GetPageCount ();
+    const auto freeChunkCount = static_cast <uint32_t> (values.size () - 1u);
+    const uint32_t releaseStartStep = 3u * pageCount + 2u * freeChunkCount;
+    uint32_t stepCount = 1u;
+
+    while (!pool.ShrinkStep (1u))
+    {
+        BOOST_REQUIRE (stepCount > releaseStartStep || pool.GetPageCount () == pageCount);
+        ++stepCount;
+    }
+
+    BOOST_REQUIRE (stepCount == releaseStartStep + pageCount + 1u);
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+}
+
+template <typename Pool>
+void TestAnyPoolReserve (Pool &pool)
+{
+    BOOST_REQUIRE_MESSAGE (pool.GetPageCount () == 0u, "New empty pool must have 0 pages.");
+    pool.Reserve (pool.GetPageCapacity () * 3u - 1u);
+
+    // Pages, that are not prefaulted, are added to pool only when they are needed.
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+
+    // Reserve never removes pages and takes pages, that are not added yet, into account.
+    pool.Reserve (pool.GetPageCapacity ());
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+
+    std::vector <typename Pool::ValueType *> values;
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 3u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 3u);
+    values.push_back (pool.Acquire ());
+    BOOST_REQUIRE (pool.GetPageCount () == 4u);
+
+    for (typename Pool::ValueType *value : values)
+    {
+        pool.Free (value);
+    }
+
+    // Released reserved pages are kept by pool and reused by next Reserve and Acquire calls.
+    pool.Shrink ();
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+    pool.Reserve (pool.GetPageCapacity () * 2u, true);
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+
+    values.clear ();
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 4u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 4u);
+    for (typename Pool::ValueType *value : values)
+    {
+        pool.Free (value);
+    }
+
+    pool.Shrink ();
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+}
+
+// Expects pool with trivial entries. Reserve in the middle of shrink pass used to let the pass release page,
+// that had live entries, because pages, added by Reserve, were counted as pages of the pass.
+template <typename Pool>
+void TestAnyPoolReserveDuringShrinkStep (Pool &pool)
+{
+    BOOST_REQUIRE_MESSAGE (pool.GetPageCount () == 0u, "New empty pool must have 0 pages.");
+    std::vector <typename Pool::ValueType *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 2u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    const auto pageBegin = values.begin () + pool.GetPageCapacity ();
+    const bool isFirstPageLower = std::less <> {} (values.front (), *pageBegin);
+
+    // Free entries of lower page, so shrink pass sees them before entries of new pages.
+    std::vector <typename Pool::ValueType *> liveValues;
+    for (auto iterator = values.begin (); iterator != values.end (); ++iterator)
+    {
+        if ((iterator < pageBegin) == isFirstPageLower)
+        {
+            pool.Free (*iterator);
+        }
+        else
+        {
+            liveValues.push_back (*iterator);
+        }
+    }
+
+    BOOST_REQUIRE (!pool.ShrinkStep (1u));
+    pool.Reserve (pool.GetPageCapacity () * 3u);
+
+    while (!pool.ShrinkStep (1u))
+    {
+    }
+
+    for (typename Pool::ValueType *value : liveValues)
+    {
+        std::memset (static_cast <void *> (value), 0xAB, sizeof (uintptr_t));
+    }
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 3u; ++itemIndex)
+    {
+        liveValues.push_back (pool.Acquire ());
+    }
+
+    std::sort (liveValues.begin (), liveValues.end ());
+    BOOST_REQUIRE (std::adjacent_find (liveValues.begin (), liveValues.end ()) == liveValues.end ());
+}
+
+template <typename Pool>
+void TestAnyPoolPageCapacityGrowth (Pool &pool)
+{
+    BOOST_REQUIRE_MESSAGE (pool.GetPageCount () == 0u, "New empty pool must have 0 pages.");
+    const uint32_t capacity = pool.GetPageCapacity ();
+    pool.SetMaxPageCapacity (capacity * 4u);
+
+    // Pages capacities are capacity, 2 * capacity, 4 * capacity and then 4 * capacity for all next pages.
+    std::vector <std::vector <typename Pool::ValueType *>> valuesPerPage;
+    valuesPerPage.resize (4u, {});
+    const uint32_t pageCapacities[] = {capacity, capacity * 2u, capacity * 4u, capacity * 4u};
+
+    for (uint32_t pageIndex = 0u; pageIndex < 4u; ++pageIndex)
+    {
+        for (uint32_t itemIndex = 0u; itemIndex < pageCapacities[pageIndex]; ++itemIndex)
+        {
+            valuesPerPage[pageIndex].push_back (pool.Acquire ());
+        }
+
+        BOOST_REQUIRE (pool.GetPageCount () == pageIndex + 1u);
+    }
+
+    auto clearPage = [&valuesPerPage, &pool] (uint32_t pageIndex)
+    {
+        for (uint32_t itemIndex = 0u; itemIndex < valuesPerPage[pageIndex].size (); ++itemIndex)
+        {
+            pool.Free (valuesPerPage[pageIndex][itemIndex]);
+        }
+
+        valuesPerPage[pageIndex].clear ();
+    };
+
+    clearPage (1u);
+    pool.Shrink ();
+    BOOST_REQUIRE (pool.GetPageCount () == 3u);
+
+    // Half of the biggest page is freed, the smallest one is kept full, so only incremental shrink is checked.
+    for (uint32_t itemIndex = capacity * 2u; itemIndex < capacity * 4u; ++itemIndex)
+    {
+        pool.Free (valuesPerPage[2u][itemIndex]);
+    }
+
+    valuesPerPage[2u].resize (capacity * 2u);
+    clearPage (3u);
+
+    while (!pool.ShrinkStep (4u))
+    {
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    clearPage (0u);
+    clearPage (2u);
+    pool.Shrink ();
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+
+    // Reserve takes page capacity growth into account, both for pages, that are added on use, and prefaulted ones.
+    pool.Reserve (capacity * 3u);
+    for (uint32_t itemIndex = 0u; itemIndex < capacity * 3u; ++itemIndex)
+    {
+        valuesPerPage[0u].push_back (pool.Acquire ());
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    clearPage (0u);
+    pool.Shrink ();
+
+    pool.Reserve (capacity * 3u, true);
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+}
+
+template <typename Pool>
+void TestAnyPoolDecommitReleasedPages (Pool &pool)
+{
+    BOOST_REQUIRE_MESSAGE (pool.GetPageCount () == 0u, "New empty pool must have 0 pages.");
+    pool.SetReleasedPageMode (Memory::ReleasedPageMode::DECOMMIT);
+    std::vector <typename Pool::ValueType *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 2u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    for (typename Pool::ValueType *value : values)
+    {
+        pool.Free (value);
+    }
+
+    pool.Shrink ();
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+    std::sort (values.begin (), values.end ());
+
+    // Decommitted pages are reused, so the same memory is returned again.
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 2u; ++itemIndex)
+    {
+        BOOST_REQUIRE (std::binary_search (values.begin (), values.end (), pool.Acquire ()));
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    pool.Acquire ();
+    BOOST_REQUIRE (pool.GetPageCount () == 3u);
+}
+
+// Pools must have the same page size.
+template <typename Pool>
+void TestAnyPoolPageDepot (Pool &first, Pool &second)
+{
+    BOOST_REQUIRE_MESSAGE (first.GetPageCount () == 0u && second.GetPageCount () == 0u,
+                           "New empty pools must have 0 pages.");
+
+    Memory::PageDepot depot {std::numeric_limits <std::size_t>::max ()};
+    first.SetPageDepot (&depot);
+    second.SetPageDepot (&depot);
+    std::vector <typename Pool::ValueType *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < first.GetPageCapacity () * 2u; ++itemIndex)
+    {
+        values.push_back (first.Acquire ());
+    }
+
+    for (typename Pool::ValueType *value : values)
+    {
+        first.Free (value);
+    }
+
+    first.Shrink ();
+    BOOST_REQUIRE (first.GetPageCount () == 0u);
+    BOOST_REQUIRE (depot.GetPageCount () == 2u);
+    std::sort (values.begin (), values.end ());
+
+    // Pages, released by first pool, are used by second pool instead of allocating new ones.
+    for (uint32_t itemIndex = 0u; itemIndex < second.GetPageCapacity () * 2u; ++itemIndex)
+    {
+        BOOST_REQUIRE (std::binary_search (values.begin (), values.end (), second.Acquire ()));
+    }
+
+    BOOST_REQUIRE (second.GetPageCount () == 2u);
+    BOOST_REQUIRE (depot.GetPageCount () == 0u);
+
+    // Clean deposits pages too.
+    second.Clean ();
+    BOOST_REQUIRE (depot.GetPageCount () == 2u);
+    BOOST_REQUIRE (std::binary_search (values.begin (), values.end (), first.Acquire ()));
+    BOOST_REQUIRE (depot.GetPageCount () == 1u);
+
+    first.Clean ();
+    first.SetPageDepot (nullptr);
+    second.SetPageDepot (nullptr);
+}
+
+// Provisioner must have the same page capacity as pool, low watermark 1 and high watermark 2.
+template <typename Pool>
+void TestAnyPoolPageProvisioner (Pool &pool, Memory::PageProvisioner &provisioner)
+{
+    BOOST_REQUIRE_MESSAGE (pool.GetPageCount () == 0u, "New empty pool must have 0 pages.");
+    pool.SetPageProvisioner (&provisioner);
+    provisioner.WaitUntilFull ();
+    BOOST_REQUIRE (provisioner.GetReadyPageCount () == 2u);
+
+    std::vector <typename Pool::ValueType *> values;
+    values.push_back (pool.Acquire ());
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+    BOOST_REQUIRE (provisioner.GetReadyPageCount () == 1u);
+
+    // Second page drops reserve below low watermark, so background thread fills it again.
+    for (uint32_t itemIndex = 1u; itemIndex < pool.GetPageCapacity () * 2u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    provisioner.WaitUntilFull ();
+    BOOST_REQUIRE (provisioner.GetReadyPageCount () == 2u);
+
+    std::sort (values.begin (), values.end ());
+    BOOST_REQUIRE (std::adjacent_find (values.begin (), values.end ()) == values.end ());
+
+    for (typename Pool::ValueType *value : values)
+    {
+        pool.Free (value);
+    }
+
+    pool.Clean ();
+    pool.SetPageProvisioner (nullptr);
+}
+
+template <typename Pool>
+void TestAnyPoolPageReleasePolicy (Pool &pool)
+{
+    BOOST_REQUIRE_MESSAGE (pool.GetPageCount () == 0u, "New empty pool must have 0 pages.");
+    pool.SetPageReleasePolicy (Memory::PageReleasePolicy::KeepSpare (1u));
+    std::vector <std::vector <typename Pool::ValueType *>> valuesPerPage;
+    valuesPerPage.resize (4u, {});
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 4u; ++itemIndex)
+    {
+        valuesPerPage[itemIndex / pool.GetPageCapacity ()].push_back (pool.Acquire ());
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 4u);
+    auto clearPage = [&valuesPerPage, &pool] (uint32_t pageIndex)
+    {
+        for (uint32_t itemIndex = 0u; itemIndex < valuesPerPage[pageIndex].size (); ++itemIndex)
+        {
+            pool.Free (valuesPerPage[pageIndex][itemIndex]);
+        }
+
+        valuesPerPage[pageIndex].clear ();
+    };
+
+    // Release is spread across Acquire and Free calls, therefore pool is used until release is finished.
+    // Free chunks outside of released pages are expected, otherwise Acquire would need new page.
+    auto finishRelease = [&pool] (Memory::SizeType expectedPageCount)
+    {
+        for (uint32_t iteration = 0u;
+             iteration < pool.GetPageCapacity () * 4u && pool.GetPageCount () != expectedPageCount; ++iteration)
+        {
+            pool.Free (pool.Acquire ());
+        }
+
+        BOOST_REQUIRE (pool.GetPageCount () == expectedPageCount);
+    };
+
+    // First empty page is kept as spare, second one triggers release.
+    clearPage (0u);
+    BOOST_REQUIRE (pool.GetPageCount () == 4u);
+    clearPage (1u);
+    finishRelease (3u);
+
+    // Crossing page boundary back and forth must not allocate or release pages.
+    for (uint32_t iteration = 0u; iteration < pool.GetPageCapacity () * 2u; ++iteration)
+    {
+        typename Pool::ValueType *value = pool.Acquire ();
+        BOOST_REQUIRE (pool.GetPageCount () == 3u);
+        pool.Free (value);
+        BOOST_REQUIRE (pool.GetPageCount () == 3u);
+    }
+
+    pool.SetPageReleasePolicy (Memory::PageReleasePolicy::ReleaseAfter (2u));
+    BOOST_REQUIRE (pool.GetPageCount () == 3u);
+    pool.Free (valuesPerPage[3u].back ());
+    valuesPerPage[3u].pop_back ();
+    clearPage (2u);
+    finishRelease (1u);
+
+    pool.SetPageReleasePolicy (Memory::PageReleasePolicy::Never ());
+    clearPage (3u);
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+
+    pool.SetPageReleasePolicy (Memory::PageReleasePolicy::KeepSpare (0u));
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+
+    // Interrupted incremental shrink must not prevent automatic release.
+    std::vector <typename Pool::ValueType *> values;
+    for (uint32_t itemIndex = 0u; itemIndex <= pool.GetPageCapacity (); ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    pool.Free (values.front ());
+    BOOST_REQUIRE (!pool.ShrinkStep (1u));
+    pool.Free (values.back ());
+    finishRelease (1u);
+}
+
+template <typename Pool, typename Compactor>
+void TestAnyPoolCompact (Pool &pool, const Compactor &compactor)
+{
+    BOOST_REQUIRE_MESSAGE (pool.GetPageCount () == 0u, "New empty pool must have 0 pages.");
+    std::vector <typename Pool::ValueType *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 3u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    // Keep only every fourth value, so values from three pages can be moved to one page.
+    for (uint32_t itemIndex = 0u; itemIndex < values.size (); ++itemIndex)
+    {
+        if (itemIndex % 4u != 0u)
+        {
+            pool.Free (values[itemIndex]);
+        }
+    }
+
+    pool.Shrink ();
+    BOOST_REQUIRE (pool.GetPageCount () == 3u);
+
+    // Use minimal budget to check that compaction can be done incrementally. Budget limits every kind of work,
+    // so pass takes several steps per value. Acquire and Free between steps must not break compaction state,
+    // but Acquire cancels the pass if free chunks are held by it, therefore it is done only once.
+    uint32_t stepCount = 1u;
+    while (!compactor (pool, 1u))
+    {
+        ++stepCount;
+        BOOST_REQUIRE (stepCount <= values.size () * 8u);
+
+        if (stepCount == values.size ())
+        {
+            pool.Free (pool.Acquire ());
+        }
+    }
+
+    BOOST_REQUIRE (stepCount > 1u);
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+    BOOST_REQUIRE (compactor (pool, 1u));
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+}
+
+// Expects that pool entry destructor increments destructorCallCount. Cleaner is used to clean the pool.
+template <typename Pool, typename Counter, typename Cleaner>
+void TestNonTrivialPoolClean (Pool &pool, Counter &destructorCallCount, const Cleaner &cleaner)
+{
+    BOOST_REQUIRE_MESSAGE (pool.GetPageCount () == 0u, "New empty pool must have 0 pages.");
+    std::vector <typename Pool::ValueType *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 3u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    uint32_t freedCount = 0u;
+    for (uint32_t itemIndex = 0u; itemIndex < values.size (); itemIndex += 3u)
+    {
+        pool.Free (values[itemIndex]);
+        ++freedCount;
+    }
+
+    destructorCallCount = 0u;
+    cleaner (pool);
+
+    BOOST_REQUIRE (destructorCallCount == values.size () - freedCount);
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+
+    // Pool must be usable after clean.
+    values.clear ();
+    TestAnyPoolAcquirePageCount (pool);
+}
+
+// Expects pool of ThrowingData entries.
+template <typename Pool>
+void TestNonTrivialPoolEmplaceThrowing (Pool &pool)
+{
+    ThrowingData *first = pool.Emplace ("first", false);
+    BOOST_REQUIRE (first->text_ == "first");
+    pool.Free (first);
+
+    // Chunk, acquired for failed construction, must be returned to pool and reused by next entry.
+    BOOST_REQUIRE_THROW (pool.Emplace ("second", true), std::runtime_error);
+    ThrowingData *third = pool.Emplace ("third", false);
+    BOOST_REQUIRE (third == first);
+    BOOST_REQUIRE (third->text_ == "third");
+    pool.Free (third);
+}
@@ -0,0 +1,192 @@
+#include "CommonCases.hpp"
+
+#include <Memory/CompactUnorderedPool.hpp>
+
+BOOST_AUTO_TEST_SUITE (CompactUnorderedTrivialPool)
+
+#define DEFAULT_PAGE_CAPACITY 32u
+
+struct TinyData
+{
+    uint8_t values_[3u];
+};
+
+BOOST_AUTO_TEST_CASE (TinyEntries)
+{
+    Memory::TypedCompactUnorderedTrivialPool <uint16_t> pool {DEFAULT_PAGE_CAPACITY};
+    // Page of 32 chunks with header does not fit into 64 bytes, so page size is 128 bytes.
+    BOOST_REQUIRE (pool.GetPageCapacity () == 48u);
+    std::vector <uint16_t *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 2u; ++itemIndex)
+    {
+        uint16_t *value = pool.Acquire ();
+        *value = static_cast <uint16_t> (itemIndex);
+        values.push_back (value);
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    for (uint32_t itemIndex = 0u; itemIndex < values.size (); ++itemIndex)
+    {
+        BOOST_REQUIRE (*values[itemIndex] == itemIndex);
+    }
+
+    // Free every second entry, then reacquire them: no new pages should be constructed.
+    for (uint32_t itemIndex = 0u; itemIndex < values.size (); itemIndex += 2u)
+    {
+        pool.Free (values[itemIndex]);
+    }
+
+    std::vector <uint16_t *> sortedValues = values;
+    std::sort (sortedValues.begin (), sortedValues.end ());
+
+    for (uint32_t itemIndex = 0u; itemIndex < values.size (); itemIndex += 2u)
+    {
+        BOOST_REQUIRE (std::binary_search (sortedValues.begin (), sortedValues.end (), pool.Acquire ()));
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    for (uint32_t itemIndex = 1u; itemIndex < values.size (); itemIndex += 2u)
+    {
+        BOOST_REQUIRE (*values[itemIndex] == itemIndex);
+    }
+
+    pool.Clean ();
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+}
+
+BOOST_AUTO_TEST_CASE (OddChunkSize)
+{
+    Memory::TypedCompactUnorderedTrivialPool <TinyData> pool {DEFAULT_PAGE_CAPACITY};
+    std::vector <TinyData *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 3u; ++itemIndex)
+    {
+        TinyData *value = pool.Acquire ();
+        value->values_[0u] = value->values_[1u] = value->values_[2u] = static_cast <uint8_t> (itemIndex);
+        values.push_back (value);
+    }
+
+    for (TinyData *value : values)
+    {
+        pool.Free (value);
+    }
+
+    for (uint32_t itemIndex = 0u; itemIndex < values.size (); ++itemIndex)
+    {
+        TinyData *value = pool.Acquire ();
+        BOOST_REQUIRE (std::find (values.begin (), values.end (), value) != values.end ());
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 3u);
+}
+
+BOOST_AUTO_TEST_CASE (PageSize)
+{
+    Memory::CompactUnorderedTrivialPool pool {Memory::PageSize {5000u}, sizeof (uint16_t)};
+    BOOST_REQUIRE (pool.GetPageSize () == 4096u);
+    BOOST_REQUIRE (pool.GetPageCapacity () == (4096u - 32u) / sizeof (uint16_t));
+
+    void *first = pool.Acquire ();
+    BOOST_REQUIRE (reinterpret_cast <uintptr_t> (first) % 4096u == 32u);
+}
+
+BOOST_AUTO_TEST_CASE (MappedPageShrink)
+{
+    // Pages of 64 KiB are mapped directly on every supported system.
+    constexpr std::size_t PAGE_SIZE = 1u << 16u;
+    Memory::CompactUnorderedTrivialPool pool {Memory::PageSize {PAGE_SIZE}, sizeof (uint32_t)};
+    BOOST_REQUIRE (pool.GetPageSize () == PAGE_SIZE);
+    std::vector <void *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 2u; ++itemIndex)
+    {
+        void *value = pool.Acquire ();
+        BOOST_REQUIRE (reinterpret_cast <uintptr_t> (value) % PAGE_SIZE >= 32u);
+        values.push_back (value);
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity (); ++itemIndex)
+    {
+        pool.Free (values[itemIndex]);
+    }
+
+    pool.Shrink ();
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+}
+
+BOOST_AUTO_TEST_CASE (Shrink)
+{
+    Memory::TypedCompactUnorderedTrivialPool <uint32_t> pool {DEFAULT_PAGE_CAPACITY};
+    std::vector <uint32_t *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 3u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    // Free first and last page, pages are filled in acquisition order.
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity (); ++itemIndex)
+    {
+        pool.Free (values[itemIndex]);
+        pool.Free (values[values.size () - 1u - itemIndex]);
+    }
+
+    pool.Free (values[pool.GetPageCapacity ()]);
+    pool.Shrink ();
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+
+    // Remaining page still has free chunk.
+    BOOST_REQUIRE (pool.Acquire () == values[pool.GetPageCapacity ()]);
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+}
+
+BOOST_AUTO_TEST_CASE (OutOfBandKeepsContent)
+{
+    struct VersionedData
+    {
+        uint64_t version_;
+        uint64_t value_;
+    };
+
+    Memory::TypedCompactUnorderedTrivialPool <VersionedData> pool {DEFAULT_PAGE_CAPACITY,
+                                                                   Memory::CompactFreeListMode::OUT_OF_BAND};
+    // Free indices stack takes 2 bytes per chunk and is padded to 32 bytes, so less chunks fit into 1024 bytes page.
+    BOOST_REQUIRE (pool.GetPageCapacity () == 54u);
+    std::vector <VersionedData *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < pool.GetPageCapacity () * 2u; ++itemIndex)
+    {
+        VersionedData *value = pool.Acquire ();
+        *value = {itemIndex, itemIndex * 2u};
+        values.push_back (value);
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    for (VersionedData *value : values)
+    {
+        pool.Free (value);
+    }
+
+    // Freed entries are not written by pool.
+    for (uint32_t itemIndex = 0u; itemIndex < values.size (); ++itemIndex)
+    {
+        BOOST_REQUIRE (values[itemIndex]->version_ == itemIndex);
+        BOOST_REQUIRE (values[itemIndex]->value_ == itemIndex * 2u);
+    }
+
+    std::vector <VersionedData *> sortedValues = values;
+    std::sort (sortedValues.begin (), sortedValues.end ());
+
+    for (uint32_t itemIndex = 0u; itemIndex < values.size (); ++itemIndex)
+    {
+        VersionedData *value = pool.Acquire ();
+        BOOST_REQUIRE (std::binary_search (sortedValues.begin (), sortedValues.end (), value));
+        BOOST_REQUIRE (value->value_ == value->version_ * 2u);
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
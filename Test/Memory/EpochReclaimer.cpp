@@ -0,0 +1,163 @@
+#include "CommonCases.hpp"
+
+#include <thread>
+
+#include <Memory/EpochReclaimer.hpp>
+#include <Memory/TypedUnorderedPool.hpp>
+
+BOOST_AUTO_TEST_SUITE (EpochReclaimer)
+
+#define DEFAULT_PAGE_CAPACITY 32u
+
+struct Node
+{
+    static constexpr uint64_t ALIVE = 0xA11FE;
+    static constexpr uint64_t DEAD = 0xDEAD;
+
+    // Free list link overwrites first bytes of freed node, therefore state is stored after value.
+    uint64_t value_ = 0u;
+    uint64_t state_ = ALIVE;
+};
+
+void NodeDestructor (Node *node) noexcept
+{
+    node->state_ = Node::DEAD;
+}
+
+using NodePool = Memory::TypedUnorderedPool <Node, Memory::EntryDefaultConstructor, NodeDestructor>;
+
+BOOST_AUTO_TEST_CASE (RetireWaitsForReaders)
+{
+    NodePool pool {DEFAULT_PAGE_CAPACITY};
+    Memory::EpochReclaimer <NodePool> reclaimer {pool, 2u, 1024u};
+    Node *node = reclaimer.Acquire ();
+
+    {
+        Memory::EpochReclaimer <NodePool>::ReadGuard guard {reclaimer, 1u};
+        reclaimer.Retire (node);
+
+        // First advance is possible, because reader has observed current epoch, but next one must wait for reader.
+        BOOST_REQUIRE (reclaimer.Collect () == 0u);
+        BOOST_REQUIRE (reclaimer.GetEpoch () == 1u);
+        BOOST_REQUIRE (reclaimer.Collect () == 0u);
+        BOOST_REQUIRE (reclaimer.GetEpoch () == 1u);
+        BOOST_REQUIRE (node->state_ == Node::ALIVE);
+    }
+
+    BOOST_REQUIRE (reclaimer.Collect () == 0u);
+    BOOST_REQUIRE (reclaimer.Collect () == 1u);
+    BOOST_REQUIRE (reclaimer.GetRetiredCount () == 0u);
+    BOOST_REQUIRE (node->state_ == Node::DEAD);
+
+    // Freed node is returned to pool.
+    BOOST_REQUIRE (reclaimer.Acquire () == node);
+}
+
+BOOST_AUTO_TEST_CASE (RetireInsideGuardDefersCollect)
+{
+    NodePool pool {DEFAULT_PAGE_CAPACITY};
+    Memory::EpochReclaimer <NodePool> reclaimer {pool, 1u, 1u};
+    Node *node = reclaimer.Acquire ();
+
+    {
+        // Batch is full right away, but reader must not free entries inside its guard.
+        Memory::EpochReclaimer <NodePool>::ReadGuard guard {reclaimer, 0u};
+        reclaimer.Retire (node);
+        BOOST_REQUIRE (reclaimer.GetEpoch () == 0u);
+    }
+
+    // Deferred collection is done on guard release.
+    BOOST_REQUIRE (reclaimer.GetEpoch () == 1u);
+    BOOST_REQUIRE (node->state_ == Node::ALIVE);
+
+    BOOST_REQUIRE (reclaimer.Collect () == 0u);
+    BOOST_REQUIRE (reclaimer.Collect () == 1u);
+    BOOST_REQUIRE (node->state_ == Node::DEAD);
+}
+
+BOOST_AUTO_TEST_CASE (BatchCollect)
+{
+    NodePool pool {DEFAULT_PAGE_CAPACITY};
+    Memory::EpochReclaimer <NodePool> reclaimer {pool, 1u, 4u};
+
+    // Every fourth retire triggers collection, so retired entries do not accumulate without readers.
+    for (uint32_t index = 0u; index < DEFAULT_PAGE_CAPACITY * 8u; ++index)
+    {
+        reclaimer.Retire (reclaimer.Acquire ());
+    }
+
+    BOOST_REQUIRE (reclaimer.GetRetiredCount () < 12u);
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+}
+
+BOOST_AUTO_TEST_CASE (ParallelReaders)
+{
+    constexpr uint32_t READER_COUNT = 4u;
+    constexpr uint32_t UPDATE_COUNT = 20000u;
+
+    NodePool pool {DEFAULT_PAGE_CAPACITY};
+    Memory::EpochReclaimer <NodePool> reclaimer {pool, READER_COUNT, 64u};
+    std::atomic <Node *> shared {reclaimer.Acquire ()};
+    std::atomic <bool> finished {false};
+
+    // Boost.Test assertions are not thread safe, therefore readers only report access to freed nodes.
+    std::atomic <bool> accessedFreed {false};
+    std::vector <std::thread> readers;
+
+    for (uint32_t readerIndex = 0u; readerIndex < READER_COUNT; ++readerIndex)
+    {
+        readers.emplace_back (
+            [&reclaimer, &shared, &finished, &accessedFreed, readerIndex] ()
+            {
+                while (!finished.load (std::memory_order_acquire))
+                {
+                    Memory::EpochReclaimer <NodePool>::ReadGuard guard {reclaimer, readerIndex};
+                    Node *node = shared.load (std::memory_order_acquire);
+
+                    for (uint32_t readIndex = 0u; readIndex < 16u; ++readIndex)
+                    {
+                        if (reinterpret_cast <volatile uint64_t &> (node->state_) != Node::ALIVE)
+                        {
+                            accessedFreed = true;
+                        }
+                    }
+                }
+            });
+    }
+
+    for (uint32_t updateIndex = 0u; updateIndex < UPDATE_COUNT; ++updateIndex)
+    {
+        Node *node = reclaimer.Acquire ();
+        node->state_ = Node::ALIVE;
+        node->value_ = updateIndex;
+        reclaimer.Retire (shared.exchange (node, std::memory_order_acq_rel));
+
+        // Writer waits for readers, when too many nodes are retired, like real producer would do.
+        while (reclaimer.GetRetiredCount () >= 1024u)
+        {
+            reclaimer.Collect ();
+            std::this_thread::yield ();
+        }
+    }
+
+    finished = true;
+    for (std::thread &reader : readers)
+    {
+        reader.join ();
+    }
+
+    BOOST_REQUIRE (!accessedFreed);
+
+    // Nodes are reused, so pool does not grow with update count.
+    BOOST_REQUIRE (pool.GetPageCount () * DEFAULT_PAGE_CAPACITY < UPDATE_COUNT);
+
+    // There are no readers anymore, so every retired node is freed after three epoch advances.
+    for (uint32_t collectIndex = 0u; collectIndex < 3u; ++collectIndex)
+    {
+        reclaimer.Collect ();
+    }
+
+    BOOST_REQUIRE (reclaimer.GetRetiredCount () == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
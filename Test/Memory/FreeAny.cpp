@@ -0,0 +1,106 @@
+#include "CommonCases.hpp"
+
+#include <Memory/FreeAny.hpp>
+#include <Memory/TypedUnorderedPool.hpp>
+#include <Memory/UnorderedPool.hpp>
+
+BOOST_AUTO_TEST_SUITE (FreeAny)
+
+#define OWNED_PAGE_SIZE Memory::PageDetail::OWNED_PAGE_ALIGNMENT
+
+static uint32_t typedDestructorCallCount = 0u;
+
+static uint32_t untypedDestructorCallCount = 0u;
+
+void TypedCountingDestructor (NonTrivialData *data) noexcept
+{
+    ++typedDestructorCallCount;
+    data->~NonTrivialData ();
+}
+
+void UntypedCountingConstructor (void *chunk) noexcept
+{
+    new (chunk) NonTrivialData ();
+}
+
+void UntypedCountingDestructor (void *chunk) noexcept
+{
+    ++untypedDestructorCallCount;
+    static_cast <NonTrivialData *> (chunk)->~NonTrivialData ();
+}
+
+BOOST_AUTO_TEST_CASE (DispatchToOwnerPool)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> trivialPool {Memory::PageSize {OWNED_PAGE_SIZE}};
+    Memory::TypedUnorderedPool <NonTrivialData, Memory::EntryDefaultConstructor, TypedCountingDestructor> typedPool {
+        Memory::PageSize {OWNED_PAGE_SIZE}};
+    Memory::UnorderedPool untypedPool {Memory::PageSize {OWNED_PAGE_SIZE}, sizeof (NonTrivialData),
+                                       UntypedCountingConstructor, UntypedCountingDestructor};
+
+    trivialPool.EnableOwnerLookup ();
+    typedPool.EnableOwnerLookup ();
+    untypedPool.EnableOwnerLookup ();
+
+    typedDestructorCallCount = 0u;
+    untypedDestructorCallCount = 0u;
+    std::vector <void *> entries;
+
+    // Entries of different pools are mixed, so every free must be dispatched to its own pool.
+    for (uint32_t index = 0u; index < typedPool.GetPageCapacity () * 2u; ++index)
+    {
+        entries.push_back (trivialPool.Acquire ());
+        entries.push_back (typedPool.Acquire ());
+        entries.push_back (untypedPool.Acquire ());
+    }
+
+    std::vector <void *> sortedEntries = entries;
+    std::sort (sortedEntries.begin (), sortedEntries.end ());
+
+    for (void *entry : entries)
+    {
+        Memory::FreeAny (entry);
+    }
+
+    BOOST_REQUIRE (typedDestructorCallCount == typedPool.GetPageCapacity () * 2u);
+    BOOST_REQUIRE (untypedDestructorCallCount == typedPool.GetPageCapacity () * 2u);
+
+    // All chunks are free again, so pools reuse them.
+    BOOST_REQUIRE (std::binary_search (sortedEntries.begin (), sortedEntries.end (), trivialPool.Acquire ()));
+    BOOST_REQUIRE (std::binary_search (sortedEntries.begin (), sortedEntries.end (), typedPool.Acquire ()));
+    BOOST_REQUIRE (std::binary_search (sortedEntries.begin (), sortedEntries.end (), untypedPool.Acquire ()));
+    BOOST_REQUIRE (typedPool.GetPageCount () == 2u);
+
+    // Null is ignored like in free.
+    Memory::FreeAny (nullptr);
+}
+
+BOOST_AUTO_TEST_CASE (OwnedPageCapacityClamp)
+{
+    // Requested pages are bigger than owned page block, so capacity must be clamped, including capacity growth.
+    Memory::TypedUnorderedPool <NonTrivialData> pool {Memory::PageSize {OWNED_PAGE_SIZE * 2u}};
+    BOOST_REQUIRE (pool.EnableOwnerLookup ());
+
+    const Memory::SizeType maxCapacity = Memory::PageDetail::GetMaxOwnedPageCapacity (sizeof (NonTrivialData));
+    BOOST_REQUIRE (pool.GetPageCapacity () == maxCapacity);
+    pool.SetMaxPageCapacity (maxCapacity * 4u);
+
+    std::vector <NonTrivialData *> entries;
+    for (uint32_t index = 0u; index < maxCapacity * 3u; ++index)
+    {
+        entries.push_back (pool.Acquire ());
+        entries.back ()->first_ = index;
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 3u);
+    for (NonTrivialData *entry : entries)
+    {
+        Memory::FreeAny (entry);
+    }
+
+    // Entries do not fit into owned page block at all, so owner lookup is rejected.
+    Memory::UnorderedTrivialPool hugePool {1u, static_cast <Memory::SizeType> (OWNED_PAGE_SIZE)};
+    BOOST_REQUIRE (!hugePool.EnableOwnerLookup ());
+    BOOST_REQUIRE (hugePool.Acquire ());
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,102 @@
+#include "CommonCases.hpp"
+
+#include <cstring>
+
+#include <Memory/MonotonicArena.hpp>
+
+BOOST_AUTO_TEST_SUITE (MonotonicArena)
+
+#define DEFAULT_PAGE_CAPACITY 1024u
+
+BOOST_AUTO_TEST_CASE (AllocateAligned)
+{
+    Memory::MonotonicArena arena {DEFAULT_PAGE_CAPACITY};
+    BOOST_REQUIRE (arena.GetPageCount () == 0u);
+
+    for (std::size_t alignment = 1u; alignment <= 64u; alignment *= 2u)
+    {
+        void *memory = arena.Allocate (3u, alignment);
+        BOOST_REQUIRE (memory);
+        BOOST_REQUIRE (reinterpret_cast <uintptr_t> (memory) % alignment == 0u);
+
+        // Write data. If it's not correctly allocated block, test could crash.
+        memset (memory, 0xAB, 3u);
+    }
+
+    BOOST_REQUIRE (arena.GetPageCount () == 1u);
+}
+
+BOOST_AUTO_TEST_CASE (AllocatePageCount)
+{
+    Memory::MonotonicArena arena {DEFAULT_PAGE_CAPACITY};
+    for (uint32_t index = 0u; index < 16u; ++index)
+    {
+        BOOST_REQUIRE (arena.Allocate (DEFAULT_PAGE_CAPACITY / 4u, 1u));
+    }
+
+    BOOST_REQUIRE (arena.GetPageCount () == 4u);
+
+    // Allocation, that is bigger than page, receives separate page.
+    auto *big = static_cast <uint8_t *> (arena.Allocate (DEFAULT_PAGE_CAPACITY * 3u, 16u));
+    BOOST_REQUIRE (big);
+    memset (big, 0xCD, DEFAULT_PAGE_CAPACITY * 3u);
+    BOOST_REQUIRE (arena.GetPageCount () == 5u);
+}
+
+BOOST_AUTO_TEST_CASE (ResetKeepsPages)
+{
+    Memory::MonotonicArena arena {DEFAULT_PAGE_CAPACITY};
+    std::vector <void *> firstFrame;
+
+    for (uint32_t index = 0u; index < 8u; ++index)
+    {
+        firstFrame.push_back (arena.Allocate (DEFAULT_PAGE_CAPACITY / 2u, 1u));
+    }
+
+    BOOST_REQUIRE (arena.GetPageCount () == 4u);
+    arena.Reset ();
+
+    // The same allocations in the next frame must reuse the same memory without new pages.
+    for (uint32_t index = 0u; index < 8u; ++index)
+    {
+        BOOST_REQUIRE (arena.Allocate (DEFAULT_PAGE_CAPACITY / 2u, 1u) == firstFrame[index]);
+    }
+
+    BOOST_REQUIRE (arena.GetPageCount () == 4u);
+    arena.Clean ();
+    BOOST_REQUIRE (arena.GetPageCount () == 0u);
+}
+
+BOOST_AUTO_TEST_CASE (ScopeRewind)
+{
+    // Page size includes page header and malloc header.
+    Memory::MonotonicArena arena {Memory::PageSize {
+        DEFAULT_PAGE_CAPACITY + Memory::PageDetail::PAGE_HEADER_SIZE + Memory::PageDetail::ALLOCATION_OVERHEAD}};
+    BOOST_REQUIRE (arena.GetPageCapacity () == DEFAULT_PAGE_CAPACITY);
+    void *beforeScope = arena.Allocate (16u, 16u);
+    void *firstInScope = nullptr;
+
+    {
+        Memory::MonotonicArena::Scope scope {arena};
+        firstInScope = arena.Allocate (16u, 16u);
+
+        for (uint32_t index = 0u; index < 4u; ++index)
+        {
+            arena.Allocate (DEFAULT_PAGE_CAPACITY / 2u, 1u);
+        }
+    }
+
+    BOOST_REQUIRE (arena.GetPageCount () == 3u);
+    BOOST_REQUIRE (arena.Allocate (16u, 16u) == firstInScope);
+    BOOST_REQUIRE (arena.Allocate (16u, 16u) != beforeScope);
+
+    // Marker, taken before first allocation, rewinds arena to the beginning.
+    Memory::MonotonicArena emptyArena {DEFAULT_PAGE_CAPACITY};
+    const Memory::MonotonicArena::Marker marker = emptyArena.GetMarker ();
+    void *first = emptyArena.Allocate (32u, 8u);
+
+    emptyArena.Rewind (marker);
+    BOOST_REQUIRE (emptyArena.Allocate (32u, 8u) == first);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,75 @@
+#include "CommonCases.hpp"
+
+#include <cstdlib>
+
+#include <Memory/PageDepot.hpp>
+#include <Memory/UnorderedPool.hpp>
+
+BOOST_AUTO_TEST_SUITE (PageDepot)
+
+#define DEFAULT_PAGE_SIZE 4096u
+
+BOOST_AUTO_TEST_CASE (WithdrawBySize)
+{
+    Memory::PageDepot depot {DEFAULT_PAGE_SIZE * 4u};
+    Memory::PagePointer small = malloc (DEFAULT_PAGE_SIZE);
+    Memory::PagePointer big = malloc (DEFAULT_PAGE_SIZE * 2u);
+
+    BOOST_REQUIRE (depot.Deposit (small, DEFAULT_PAGE_SIZE));
+    BOOST_REQUIRE (depot.Deposit (big, DEFAULT_PAGE_SIZE * 2u));
+    BOOST_REQUIRE (depot.GetPageCount () == 2u);
+    BOOST_REQUIRE (depot.GetSize () == DEFAULT_PAGE_SIZE * 3u);
+
+    // Pages are withdrawn only by exact size.
+    BOOST_REQUIRE (depot.Withdraw (DEFAULT_PAGE_SIZE * 4u) == nullptr);
+    BOOST_REQUIRE (depot.Withdraw (DEFAULT_PAGE_SIZE * 2u) == big);
+    BOOST_REQUIRE (depot.Withdraw (DEFAULT_PAGE_SIZE * 2u) == nullptr);
+    BOOST_REQUIRE (depot.GetSize () == DEFAULT_PAGE_SIZE);
+    free (big);
+
+    // Page, that is left in depot, is freed by depot.
+}
+
+BOOST_AUTO_TEST_CASE (Capacity)
+{
+    Memory::PageDepot depot {DEFAULT_PAGE_SIZE * 2u};
+    Memory::PagePointer first = malloc (DEFAULT_PAGE_SIZE);
+    Memory::PagePointer second = malloc (DEFAULT_PAGE_SIZE);
+    Memory::PagePointer third = malloc (DEFAULT_PAGE_SIZE);
+
+    BOOST_REQUIRE (depot.Deposit (first, DEFAULT_PAGE_SIZE));
+    BOOST_REQUIRE (depot.Deposit (second, DEFAULT_PAGE_SIZE));
+    BOOST_REQUIRE (!depot.Deposit (third, DEFAULT_PAGE_SIZE));
+    BOOST_REQUIRE (depot.GetPageCount () == 2u);
+    free (third);
+
+    depot.Clean ();
+    BOOST_REQUIRE (depot.GetPageCount () == 0u);
+    BOOST_REQUIRE (depot.GetSize () == 0u);
+}
+
+BOOST_AUTO_TEST_CASE (PoolsWithDifferentChunkSize)
+{
+    // Pools with different chunk sizes share pages if page byte size is the same: 4064 bytes, that are left after
+    // page and malloc headers, are divisible by 16 and 32.
+    Memory::PageDepot depot {std::numeric_limits <std::size_t>::max ()};
+    Memory::UnorderedTrivialPool small {Memory::PageSize {DEFAULT_PAGE_SIZE}, 16u};
+    Memory::UnorderedTrivialPool big {Memory::PageSize {DEFAULT_PAGE_SIZE}, 32u};
+    small.SetPageDepot (&depot);
+    big.SetPageDepot (&depot);
+
+    void *smallEntry = small.Acquire ();
+    small.Free (smallEntry);
+    small.Shrink ();
+    BOOST_REQUIRE (depot.GetPageCount () == 1u);
+
+    void *bigEntry = big.Acquire ();
+    BOOST_REQUIRE (depot.GetPageCount () == 0u);
+    BOOST_REQUIRE (bigEntry == smallEntry);
+    big.Free (bigEntry);
+
+    big.Clean ();
+    BOOST_REQUIRE (depot.GetPageCount () == 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
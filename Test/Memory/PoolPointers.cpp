@@ -0,0 +1,105 @@
+#include "CommonCases.hpp"
+
+#include <Memory/PoolPointers.hpp>
+#include <Memory/TypedUnorderedPool.hpp>
+
+BOOST_AUTO_TEST_SUITE (PoolPointers)
+
+#define OWNED_PAGE_SIZE Memory::PageDetail::OWNED_PAGE_ALIGNMENT
+
+struct SharedData : public Memory::PoolSharedEntry
+{
+    uint64_t value_ = 0u;
+};
+
+static uint32_t sharedDataDestructorCallCount = 0u;
+
+void CountingSharedDataDestructor (SharedData *data) noexcept
+{
+    ++sharedDataDestructorCallCount;
+    data->~SharedData ();
+}
+
+BOOST_AUTO_TEST_CASE (PointerSize)
+{
+    static_assert (sizeof (Memory::PoolUniquePtr <TrivialData>) == sizeof (void *));
+    static_assert (sizeof (Memory::PoolSharedPtr <SharedData>) == sizeof (void *));
+}
+
+BOOST_AUTO_TEST_CASE (UniquePtrFreesToPool)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {Memory::PageSize {OWNED_PAGE_SIZE}};
+    pool.EnableOwnerLookup ();
+    TrivialData *entry = nullptr;
+
+    {
+        Memory::PoolUniquePtr <TrivialData> pointer {pool.Acquire ()};
+        entry = pointer.Get ();
+        BOOST_REQUIRE (pointer);
+
+        Memory::PoolUniquePtr <TrivialData> moved {std::move (pointer)};
+        BOOST_REQUIRE (!pointer);
+        BOOST_REQUIRE (moved.Get () == entry);
+    }
+
+    // Entry was freed, therefore it is returned by next acquire.
+    BOOST_REQUIRE (pool.Acquire () == entry);
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+}
+
+BOOST_AUTO_TEST_CASE (SharedPtrFreesWithLastReference)
+{
+    Memory::TypedUnorderedPool <SharedData, Memory::EntryDefaultConstructor, CountingSharedDataDestructor> pool {
+        Memory::PageSize {OWNED_PAGE_SIZE}};
+    pool.EnableOwnerLookup ();
+    sharedDataDestructorCallCount = 0u;
+
+    Memory::PoolSharedPtr <SharedData> first {pool.Acquire ()};
+    SharedData *entry = first.Get ();
+    BOOST_REQUIRE (first.GetReferenceCount () == 1u);
+
+    {
+        Memory::PoolSharedPtr <SharedData> second {first};
+        Memory::PoolSharedPtr <SharedData> third;
+        third = second;
+        BOOST_REQUIRE (first.GetReferenceCount () == 3u);
+    }
+
+    BOOST_REQUIRE (first.GetReferenceCount () == 1u);
+    BOOST_REQUIRE (sharedDataDestructorCallCount == 0u);
+
+    first.Reset ();
+    BOOST_REQUIRE (sharedDataDestructorCallCount == 1u);
+    BOOST_REQUIRE (pool.Acquire () == entry);
+}
+
+BOOST_AUTO_TEST_CASE (OwnerUpdatedOnPoolMove)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> source {Memory::PageSize {OWNED_PAGE_SIZE}};
+    source.EnableOwnerLookup ();
+    source.SetReleasedPageMode (Memory::ReleasedPageMode::DECOMMIT);
+
+    Memory::PoolUniquePtr <TrivialData> pointer {source.Acquire ()};
+    TrivialData *entry = pointer.Get ();
+
+    // Second page is kept after shrink, its owner must be updated too.
+    std::vector <TrivialData *> values;
+    for (uint32_t index = 0u; index < source.GetPageCapacity (); ++index)
+    {
+        values.push_back (source.Acquire ());
+    }
+
+    for (TrivialData *value : values)
+    {
+        source.Free (value);
+    }
+
+    source.Shrink ();
+    BOOST_REQUIRE (source.GetPageCount () == 1u);
+
+    Memory::TypedUnorderedTrivialPool <TrivialData> target {std::move (source)};
+    pointer.Reset ();
+    BOOST_REQUIRE (target.Acquire () == entry);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,144 @@
+#include "CommonCases.hpp"
+
+#include <thread>
+
+#include <Memory/ShardedUnorderedPool.hpp>
+
+BOOST_AUTO_TEST_SUITE (ShardedUnorderedTrivialPool)
+
+#define DEFAULT_PAGE_CAPACITY 32u
+
+BOOST_AUTO_TEST_CASE (AcquireFree)
+{
+    Memory::ShardedUnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData), 1u};
+    BOOST_REQUIRE (pool.GetShardCount () == 1u);
+    std::vector <void *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < DEFAULT_PAGE_CAPACITY * 2u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    std::sort (values.begin (), values.end ());
+    BOOST_REQUIRE (std::adjacent_find (values.begin (), values.end ()) == values.end ());
+
+    for (void *value : values)
+    {
+        pool.Free (value);
+    }
+
+    // Freed chunks are reused, so no new pages are constructed.
+    for (uint32_t itemIndex = 0u; itemIndex < DEFAULT_PAGE_CAPACITY * 2u; ++itemIndex)
+    {
+        BOOST_REQUIRE (std::binary_search (values.begin (), values.end (), pool.Acquire ()));
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    pool.Clean ();
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+}
+
+BOOST_AUTO_TEST_CASE (FreeOnOtherShard)
+{
+    constexpr uint32_t ITEM_COUNT = DEFAULT_PAGE_CAPACITY * 4u;
+    constexpr uint32_t ITERATION_COUNT = 16u;
+
+    // Producer acquires on one shard and consumer frees on another, so without spilling every iteration would
+    // construct new pages while freed chunks pile up on consumer shard.
+    Memory::ShardedUnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData), 2u};
+    std::vector <void *> values;
+
+    for (uint32_t iteration = 0u; iteration < ITERATION_COUNT; ++iteration)
+    {
+        for (uint32_t itemIndex = 0u; itemIndex < ITEM_COUNT; ++itemIndex)
+        {
+            values.push_back (pool.AcquireFromShard (0u));
+        }
+
+        std::sort (values.begin (), values.end ());
+        BOOST_REQUIRE (std::adjacent_find (values.begin (), values.end ()) == values.end ());
+
+        for (void *value : values)
+        {
+            pool.FreeToShard (value, 1u);
+        }
+
+        values.clear ();
+    }
+
+    // Live entries fill 4 pages, consumer shard keeps no more than 2 pages worth of chunks, 1 more page may be
+    // split between producer shard and shared free list.
+    BOOST_REQUIRE (pool.GetPageCount () <= 7u);
+}
+
+BOOST_AUTO_TEST_CASE (ParallelAcquireFree)
+{
+    constexpr uint32_t THREAD_COUNT = 8u;
+    constexpr uint32_t ITEM_COUNT = 1024u;
+    constexpr uint32_t ITERATION_COUNT = 16u;
+
+    Memory::ShardedUnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
+    std::vector <std::vector <TrivialData *>> valuesPerThread (THREAD_COUNT);
+    std::vector <std::thread> threads;
+
+    // Boost.Test assertions are not thread safe, therefore threads only report data corruption.
+    std::atomic <bool> corrupted {false};
+
+    for (uint32_t threadIndex = 0u; threadIndex < THREAD_COUNT; ++threadIndex)
+    {
+        threads.emplace_back (
+            [&pool, &values = valuesPerThread[threadIndex], &corrupted, threadIndex] ()
+            {
+                for (uint32_t iteration = 0u; iteration < ITERATION_COUNT; ++iteration)
+                {
+                    for (uint32_t itemIndex = 0u; itemIndex < ITEM_COUNT; ++itemIndex)
+                    {
+                        auto *value = static_cast <TrivialData *> (pool.Acquire ());
+                        value->otherValue_ = threadIndex;
+                        values.push_back (value);
+                    }
+
+                    for (TrivialData *value : values)
+                    {
+                        if (value->otherValue_ != threadIndex)
+                        {
+                            corrupted = true;
+                        }
+                    }
+
+                    // Last iteration keeps entries, so uniqueness across threads can be checked.
+                    if (iteration + 1u < ITERATION_COUNT)
+                    {
+                        for (TrivialData *value : values)
+                        {
+                            pool.Free (value);
+                        }
+
+                        values.clear ();
+                    }
+                }
+            });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join ();
+    }
+
+    BOOST_REQUIRE (!corrupted);
+
+    std::vector <TrivialData *> allValues;
+    for (const std::vector <TrivialData *> &values : valuesPerThread)
+    {
+        allValues.insert (allValues.end (), values.begin (), values.end ());
+    }
+
+    std::sort (allValues.begin (), allValues.end ());
+    BOOST_REQUIRE (std::adjacent_find (allValues.begin (), allValues.end ()) == allValues.end ());
+
+    // Entries, freed by other threads, are reused by current shard.
+    BOOST_REQUIRE (pool.GetPageCount () * DEFAULT_PAGE_CAPACITY < THREAD_COUNT * ITEM_COUNT * ITERATION_COUNT);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
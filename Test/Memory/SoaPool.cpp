@@ -0,0 +1,139 @@
+#include "CommonCases.hpp"
+
+#include <Memory/SoaPool.hpp>
+
+BOOST_AUTO_TEST_SUITE (SoaPool)
+
+#define DEFAULT_PAGE_CAPACITY 32u
+
+using ParticlePool = Memory::SoaPool <float, float, float, uint8_t>;
+
+BOOST_AUTO_TEST_CASE (AcquireFree)
+{
+    ParticlePool pool {DEFAULT_PAGE_CAPACITY};
+    std::vector <Memory::SizeType> slots;
+
+    for (uint32_t index = 0u; index < DEFAULT_PAGE_CAPACITY * 2u; ++index)
+    {
+        const Memory::SizeType slot = pool.Acquire ();
+        pool.Get <0u> (slot) = static_cast <float> (index);
+        pool.Get <1u> (slot) = static_cast <float> (index) * 2.0f;
+        pool.Get <2u> (slot) = static_cast <float> (index) * 3.0f;
+        pool.Get <3u> (slot) = static_cast <uint8_t> (index);
+        slots.push_back (slot);
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    for (uint32_t index = 0u; index < slots.size (); ++index)
+    {
+        BOOST_REQUIRE (pool.Get <0u> (slots[index]) == static_cast <float> (index));
+        BOOST_REQUIRE (pool.Get <1u> (slots[index]) == static_cast <float> (index) * 2.0f);
+        BOOST_REQUIRE (pool.Get <2u> (slots[index]) == static_cast <float> (index) * 3.0f);
+        BOOST_REQUIRE (pool.Get <3u> (slots[index]) == static_cast <uint8_t> (index));
+    }
+
+    // Freed slot is reused before new page is allocated.
+    pool.Free (slots[5u]);
+    BOOST_REQUIRE (pool.Acquire () == slots[5u]);
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+
+    // Const pool gives read only access to the same values.
+    const ParticlePool &constPool = pool;
+    BOOST_REQUIRE (constPool.Get <2u> (slots[7u]) == 21.0f);
+    static_assert (std::is_same_v <decltype (constPool.Get <2u> (0u)), const float &>);
+    static_assert (std::is_same_v <decltype (constPool.GetPageField <2u> (0u)), const float *>);
+
+    pool.Clean ();
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+}
+
+BOOST_AUTO_TEST_CASE (PageFieldIteration)
+{
+    ParticlePool pool {DEFAULT_PAGE_CAPACITY};
+    for (uint32_t index = 0u; index < DEFAULT_PAGE_CAPACITY; ++index)
+    {
+        const Memory::SizeType slot = pool.Acquire ();
+        pool.Get <0u> (slot) = 1.0f;
+        pool.Get <1u> (slot) = 2.0f;
+    }
+
+    float *xs = pool.GetPageField <0u> (0u);
+    const float *ys = pool.GetPageField <1u> (0u);
+    BOOST_REQUIRE (reinterpret_cast <uintptr_t> (xs) % ParticlePool::FIELD_ALIGNMENT == 0u);
+    BOOST_REQUIRE (reinterpret_cast <uintptr_t> (ys) % ParticlePool::FIELD_ALIGNMENT == 0u);
+    BOOST_REQUIRE (reinterpret_cast <uintptr_t> (pool.GetPageField <3u> (0u)) % ParticlePool::FIELD_ALIGNMENT == 0u);
+
+    // Field arrays are contiguous, so such loops can be vectorized by compiler.
+    for (uint32_t index = 0u; index < pool.GetPageCapacity (); ++index)
+    {
+        xs[index] += ys[index];
+    }
+
+    for (uint32_t slot = 0u; slot < DEFAULT_PAGE_CAPACITY; ++slot)
+    {
+        BOOST_REQUIRE (pool.Get <0u> (slot) == 3.0f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (LiveMask)
+{
+    // Capacity is bigger than 64, so live mask of every page takes two words.
+    ParticlePool pool {100u};
+    std::vector <Memory::SizeType> slots;
+
+    for (uint32_t index = 0u; index < 100u; ++index)
+    {
+        slots.push_back (pool.Acquire ());
+        BOOST_REQUIRE (slots.back () != ParticlePool::INVALID_SLOT);
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+    BOOST_REQUIRE (pool.GetPageLiveCount (0u) == 100u);
+
+    for (uint32_t index = 0u; index < 100u; index += 3u)
+    {
+        pool.Free (slots[index]);
+    }
+
+    const uint64_t *mask = pool.GetPageLiveMask (0u);
+    uint32_t liveCount = 0u;
+
+    for (uint32_t index = 0u; index < 100u; ++index)
+    {
+        const bool live = (mask[index / 64u] >> index % 64u & 1u) != 0u;
+        BOOST_REQUIRE (live == (index % 3u != 0u));
+        BOOST_REQUIRE (pool.IsLive (slots[index]) == live);
+        liveCount += live ? 1u : 0u;
+    }
+
+    BOOST_REQUIRE (pool.GetPageLiveCount (0u) == liveCount);
+
+    // Freed slots of full page are reused before the second page is constructed.
+    for (uint32_t index = liveCount; index < 100u; ++index)
+    {
+        BOOST_REQUIRE (pool.Acquire () / pool.GetPageCapacity () == 0u);
+    }
+
+    BOOST_REQUIRE (pool.GetPageLiveCount (0u) == 100u);
+    BOOST_REQUIRE (pool.Acquire () == 100u);
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    BOOST_REQUIRE (pool.GetPageLiveCount (1u) == 1u);
+    BOOST_REQUIRE (!pool.IsLive (101u));
+}
+
+BOOST_AUTO_TEST_CASE (MoveConstruct)
+{
+    ParticlePool pool {DEFAULT_PAGE_CAPACITY};
+    const Memory::SizeType slot = pool.Acquire ();
+    pool.Get <0u> (slot) = 5.0f;
+
+    ParticlePool moved {std::move (pool)};
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+    BOOST_REQUIRE (moved.GetPageCount () == 1u);
+    BOOST_REQUIRE (moved.Get <0u> (slot) == 5.0f);
+
+    moved.Free (slot);
+    BOOST_REQUIRE (moved.Acquire () == slot);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,94 @@
+#include "CommonCases.hpp"
+
+#include <new>
+
+#include <Memory/StaticTypedPool.hpp>
+
+BOOST_AUTO_TEST_SUITE (StaticTypedPool)
+
+#define DEFAULT_CAPACITY 32u
+
+static uint32_t nonTrivialDataDestructorCallCount = 0u;
+
+void CountingNonTrivialDataDestructor (NonTrivialData *data) noexcept
+{
+    ++nonTrivialDataDestructorCallCount;
+    Memory::EntryDefaultDestructor (data);
+}
+
+BOOST_AUTO_TEST_CASE (TryAcquireWhenFull)
+{
+    Memory::StaticTypedPool <TrivialData, DEFAULT_CAPACITY> pool;
+    std::vector <TrivialData *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < DEFAULT_CAPACITY; ++itemIndex)
+    {
+        TrivialData *value = pool.TryAcquire ();
+        BOOST_REQUIRE (value);
+        value->otherValue_ = itemIndex;
+        values.push_back (value);
+    }
+
+    BOOST_REQUIRE (pool.GetUsedCount () == DEFAULT_CAPACITY);
+    BOOST_REQUIRE (!pool.TryAcquire ());
+
+    // All entries are stored inside pool object.
+    const auto *poolBegin = reinterpret_cast <const uint8_t *> (&pool);
+    for (uint32_t itemIndex = 0u; itemIndex < DEFAULT_CAPACITY; ++itemIndex)
+    {
+        const auto *value = reinterpret_cast <const uint8_t *> (values[itemIndex]);
+        BOOST_REQUIRE (value >= poolBegin && value < poolBegin + sizeof (pool));
+        BOOST_REQUIRE (values[itemIndex]->otherValue_ == itemIndex);
+    }
+
+    pool.Free (values[7u]);
+    BOOST_REQUIRE (pool.TryAcquire () == values[7u]);
+    BOOST_REQUIRE (!pool.TryAcquire ());
+
+    pool.Clean ();
+    BOOST_REQUIRE (pool.GetUsedCount () == 0u);
+    BOOST_REQUIRE (pool.Acquire () == values[0u]);
+}
+
+BOOST_AUTO_TEST_CASE (CleanDestructsUsedEntries)
+{
+    nonTrivialDataDestructorCallCount = 0u;
+    Memory::StaticTypedPool <NonTrivialData, DEFAULT_CAPACITY, Memory::EntryDefaultConstructor,
+                             CountingNonTrivialDataDestructor> pool;
+    std::vector <NonTrivialData *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < DEFAULT_CAPACITY; ++itemIndex)
+    {
+        NonTrivialData *value = pool.Acquire ();
+        BOOST_REQUIRE (*value == NonTrivialData ());
+        value->values_.push_back (itemIndex);
+        values.push_back (value);
+    }
+
+    for (uint32_t itemIndex = 0u; itemIndex < DEFAULT_CAPACITY; itemIndex += 3u)
+    {
+        pool.Free (values[itemIndex]);
+    }
+
+    // Clean must destruct only entries, that are still used.
+    pool.Clean ();
+    BOOST_REQUIRE (nonTrivialDataDestructorCallCount == DEFAULT_CAPACITY);
+}
+
+BOOST_AUTO_TEST_CASE (UserProvidedStorage)
+{
+    using Pool = Memory::StaticTypedPool <TrivialData, DEFAULT_CAPACITY>;
+    alignas (Pool) static uint8_t buffer[sizeof (Pool)];
+
+    auto *pool = new (buffer) Pool ();
+    TestTrivialPoolAcquireFree (
+        *pool,
+        [] (TrivialData *chunk)
+        {
+            chunk->otherValue_ = 42u;
+        });
+
+    pool->~Pool ();
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
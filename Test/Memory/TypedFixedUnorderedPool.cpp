@@ -0,0 +1,104 @@
+#include "CommonCases.hpp"
+
+#include <Memory/TypedFixedUnorderedPool.hpp>
+
+BOOST_AUTO_TEST_SUITE (TypedFixedUnorderedPool)
+
+#define DEFAULT_PAGE_CAPACITY 32u
+
+static std::atomic <uint32_t> nonTrivialDataDestructorCallCount {0u};
+
+void CountingNonTrivialDataDestructor (NonTrivialData *data) noexcept
+{
+    ++nonTrivialDataDestructorCallCount;
+    Memory::EntryDefaultDestructor (data);
+}
+
+using NonTrivialPool = Memory::TypedFixedUnorderedPool <
+    NonTrivialData, DEFAULT_PAGE_CAPACITY, Memory::EntryDefaultConstructor, CountingNonTrivialDataDestructor>;
+
+static_assert (Memory::TypedFixedUnorderedPool <TrivialData, DEFAULT_PAGE_CAPACITY>::GetPageCapacity () ==
+               DEFAULT_PAGE_CAPACITY);
+
+BOOST_AUTO_TEST_CASE (AcquireAndFree)
+{
+    NonTrivialPool pool;
+    nonTrivialDataDestructorCallCount = 0u;
+
+    NonTrivialData *data = pool.Acquire ();
+    BOOST_REQUIRE (*data == NonTrivialData ());
+    pool.Free (data);
+    BOOST_REQUIRE (nonTrivialDataDestructorCallCount == 1u);
+}
+
+BOOST_AUTO_TEST_CASE (AcquirePageCount)
+{
+    Memory::TypedFixedUnorderedPool <TrivialData, DEFAULT_PAGE_CAPACITY> pool;
+    TestAnyPoolAcquirePageCount (pool);
+}
+
+BOOST_AUTO_TEST_CASE (Shrink)
+{
+    Memory::TypedFixedUnorderedPool <TrivialData, DEFAULT_PAGE_CAPACITY> pool;
+    TestAnyPoolShrink (pool);
+}
+
+BOOST_AUTO_TEST_CASE (Reserve)
+{
+    Memory::TypedFixedUnorderedPool <TrivialData, DEFAULT_PAGE_CAPACITY> pool;
+    TestAnyPoolReserve (pool);
+}
+
+BOOST_AUTO_TEST_CASE (Clean)
+{
+    NonTrivialPool pool;
+    TestNonTrivialPoolClean (
+        pool, nonTrivialDataDestructorCallCount,
+        [] (auto &pool)
+        {
+            pool.Clean ();
+        });
+}
+
+BOOST_AUTO_TEST_CASE (Emplace)
+{
+    NonTrivialPool pool;
+    NonTrivialData *data = pool.Emplace (NonTrivialData {{1u, 2u}, 3u, 4u});
+    BOOST_REQUIRE (data->values_.size () == 2u);
+    BOOST_REQUIRE (data->first_ == 3u);
+    BOOST_REQUIRE (data->second_ == 4u);
+
+    NonTrivialData *copied = pool.Emplace (*data);
+    BOOST_REQUIRE (*copied == *data);
+    pool.Free (data);
+    pool.Free (copied);
+}
+
+BOOST_AUTO_TEST_CASE (EmplaceThrowing)
+{
+    Memory::TypedFixedUnorderedPool <ThrowingData, DEFAULT_PAGE_CAPACITY> pool;
+    TestNonTrivialPoolEmplaceThrowing (pool);
+}
+
+BOOST_AUTO_TEST_CASE (IsFrom)
+{
+    Memory::TypedFixedUnorderedPool <TrivialData, DEFAULT_PAGE_CAPACITY> pool;
+    std::vector <TrivialData *> values;
+
+    for (uint32_t itemIndex = 0u; itemIndex < DEFAULT_PAGE_CAPACITY * 2u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    for (TrivialData *value : values)
+    {
+        BOOST_REQUIRE (pool.IsFrom (value));
+        // Address inside chunk is not a chunk address.
+        BOOST_REQUIRE (!pool.IsFrom (reinterpret_cast <TrivialData *> (reinterpret_cast <uint8_t *> (value) + 1u)));
+    }
+
+    TrivialData outside {};
+    BOOST_REQUIRE (!pool.IsFrom (&outside));
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,172 @@
+#include "CommonCases.hpp"
+
+#include <Memory/TypedHandlePool.hpp>
+
+BOOST_AUTO_TEST_SUITE (TypedHandlePool)
+
+#define DEFAULT_PAGE_CAPACITY 32u
+#define DEFAULT_PAGE_SIZE 4096u
+
+static bool nonTrivialDataDestructorCalled = false;
+
+void CustomNonTrivialDataDestructor (NonTrivialData *data) noexcept
+{
+    nonTrivialDataDestructorCalled = true;
+    Memory::EntryDefaultDestructor (data);
+}
+
+BOOST_AUTO_TEST_CASE (AcquireResolveAndFree)
+{
+    nonTrivialDataDestructorCalled = false;
+    Memory::TypedHandlePool <
+        NonTrivialData, Memory::EntryDefaultConstructor, CustomNonTrivialDataDestructor> pool {DEFAULT_PAGE_CAPACITY};
+
+    Memory::PoolHandle handle = pool.Acquire ();
+    BOOST_REQUIRE (handle != Memory::PoolHandle::Invalid ());
+
+    NonTrivialData *data = pool.Resolve (handle);
+    BOOST_REQUIRE (data);
+    BOOST_REQUIRE (*data == NonTrivialData ());
+
+    pool.Free (handle);
+    BOOST_REQUIRE (nonTrivialDataDestructorCalled);
+    BOOST_REQUIRE (!pool.Resolve (handle));
+}
+
+BOOST_AUTO_TEST_CASE (StaleHandleAfterReuse)
+{
+    Memory::TypedHandlePool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    Memory::PoolHandle first = pool.Acquire ();
+    NonTrivialData *firstData = pool.Resolve (first);
+    pool.Free (first);
+
+    // Freed slot is on the top of free list, therefore it will be reused with new generation.
+    Memory::PoolHandle second = pool.Acquire ();
+    BOOST_REQUIRE (second != first);
+    BOOST_REQUIRE (pool.Resolve (second) == firstData);
+    BOOST_REQUIRE (!pool.Resolve (first));
+}
+
+BOOST_AUTO_TEST_CASE (FreeStaleHandle)
+{
+    Memory::TypedHandlePool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    Memory::PoolHandle first = pool.Acquire ();
+    pool.Free (first);
+    Memory::PoolHandle second = pool.Acquire ();
+
+    // Double free must neither destruct nor release slot, that is already reused by second handle.
+    pool.Free (first);
+    pool.Free (Memory::PoolHandle::Invalid ());
+    BOOST_REQUIRE (pool.Resolve (second));
+
+    Memory::PoolHandle third = pool.Acquire ();
+    BOOST_REQUIRE (pool.Resolve (third) != pool.Resolve (second));
+}
+
+BOOST_AUTO_TEST_CASE (ForgedHandles)
+{
+    Memory::TypedHandlePool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    Memory::PoolHandle handle = pool.Acquire ();
+    const uint32_t address = handle.value_ & ((1u << Memory::PoolHandle::GENERATION_SHIFT) - 1u);
+    const uint32_t generationCount = 1u << Memory::PoolHandle::GENERATION_BITS;
+
+    // Other slots of the page were never acquired, so their handles must not be resolved with any generation.
+    for (uint32_t slotIndex = 1u; slotIndex < DEFAULT_PAGE_CAPACITY; ++slotIndex)
+    {
+        for (uint32_t generation = 0u; generation < generationCount; ++generation)
+        {
+            BOOST_REQUIRE (!pool.Resolve ({(generation << Memory::PoolHandle::GENERATION_SHIFT) |
+                                           (address ^ slotIndex)}));
+        }
+    }
+
+    pool.Free (handle);
+    for (uint32_t generation = 0u; generation < generationCount; ++generation)
+    {
+        BOOST_REQUIRE (!pool.Resolve ({(generation << Memory::PoolHandle::GENERATION_SHIFT) | address}));
+    }
+}
+
+BOOST_AUTO_TEST_CASE (ResolveAfterClean)
+{
+    Memory::TypedHandlePool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    std::vector <Memory::PoolHandle> oldHandles;
+
+    for (uint32_t index = 0u; index < DEFAULT_PAGE_CAPACITY * 2u; ++index)
+    {
+        oldHandles.push_back (pool.Acquire ());
+    }
+
+    pool.Free (oldHandles[0u]);
+    pool.Clean ();
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+
+    for (uint32_t index = 0u; index < DEFAULT_PAGE_CAPACITY * 2u; ++index)
+    {
+        pool.Acquire ();
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    for (Memory::PoolHandle handle : oldHandles)
+    {
+        BOOST_REQUIRE (!pool.Resolve (handle));
+    }
+}
+
+BOOST_AUTO_TEST_CASE (ResolveOnManyPages)
+{
+    Memory::TypedHandlePool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    std::vector <Memory::PoolHandle> handles;
+
+    for (uint32_t index = 0u; index < DEFAULT_PAGE_CAPACITY * 3u; ++index)
+    {
+        handles.push_back (pool.Acquire ());
+        pool.Resolve (handles.back ())->first_ = index;
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 3u);
+    for (uint32_t index = 0u; index < handles.size (); ++index)
+    {
+        BOOST_REQUIRE (pool.Resolve (handles[index])->first_ == index);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (ResolveAfterReserve)
+{
+    Memory::TypedHandlePool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    pool.Reserve (DEFAULT_PAGE_CAPACITY * 2u, true);
+    BOOST_REQUIRE (pool.GetPageCount () == 2u);
+    std::vector <Memory::PoolHandle> handles;
+
+    for (uint32_t index = 0u; index < DEFAULT_PAGE_CAPACITY * 3u; ++index)
+    {
+        handles.push_back (pool.Acquire ());
+        pool.Resolve (handles.back ())->first_ = index;
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 3u);
+    for (uint32_t index = 0u; index < handles.size (); ++index)
+    {
+        BOOST_REQUIRE (pool.Resolve (handles[index])->first_ == index);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (AcquirePageCount)
+{
+    Memory::TypedHandlePool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolAcquirePageCount (pool);
+}
+
+BOOST_AUTO_TEST_CASE (AcquirePageCountWithPageSize)
+{
+    Memory::TypedHandlePool <NonTrivialData> pool {Memory::PageSize {DEFAULT_PAGE_SIZE}};
+    const Memory::SizeType capacity = pool.GetPageCapacity ();
+
+    // Slot is bigger than entry, because it also stores handle, so only lower bound is checked for entries.
+    BOOST_REQUIRE (capacity > 0u);
+    BOOST_REQUIRE ((capacity & (capacity - 1u)) == 0u);
+    BOOST_REQUIRE (Memory::PageDetail::PAGE_HEADER_SIZE + capacity * sizeof (NonTrivialData) <= DEFAULT_PAGE_SIZE);
+    TestAnyPoolAcquirePageCount (pool);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -5,6 +5,10 @@
 BOOST_AUTO_TEST_SUITE (TypedUnorderedPool)
 
 #define DEFAULT_PAGE_CAPACITY 32u
+#define DEFAULT_PAGE_SIZE 4096u
+
+// Pages must span several operating system pages, otherwise there is nothing to decommit.
+#define DECOMMIT_PAGE_SIZE 65536u
 
 static bool nonTrivialDataDestructorCalled = false;
 
@@ -14,6 +18,14 @@ void CustomNonTrivialDataDestructor (NonTrivialData *data) noexcept
     Memory::EntryDefaultDestructor (data);
 }
 
+static std::atomic <uint32_t> nonTrivialDataDestructorCallCount {0u};
+
+void CountingNonTrivialDataDestructor (NonTrivialData *data) noexcept
+{
+    ++nonTrivialDataDestructorCallCount;
+    Memory::EntryDefaultDestructor (data);
+}
+
 BOOST_AUTO_TEST_CASE (AcquireAndFree)
 {
     nonTrivialDataDestructorCalled = false;
@@ -28,10 +40,258 @@ BOOST_AUTO_TEST_CASE (AcquirePageCount)
     TestAnyPoolAcquirePageCount (pool);
 }
 
+BOOST_AUTO_TEST_CASE (AcquirePageCountWithPageSize)
+{
+    Memory::TypedUnorderedPool <NonTrivialData> pool {Memory::PageSize {DEFAULT_PAGE_SIZE}};
+    TestAnyPoolPageSize (pool, DEFAULT_PAGE_SIZE, sizeof (NonTrivialData));
+}
+
 BOOST_AUTO_TEST_CASE (Shrink)
 {
     Memory::TypedUnorderedPool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
     TestAnyPoolShrink (pool);
 }
 
+BOOST_AUTO_TEST_CASE (ShrinkStep)
+{
+    Memory::TypedUnorderedPool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolShrinkStep (pool);
+}
+
+BOOST_AUTO_TEST_CASE (Reserve)
+{
+    Memory::TypedUnorderedPool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolReserve (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageCapacityGrowth)
+{
+    Memory::TypedUnorderedPool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolPageCapacityGrowth (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageReleasePolicy)
+{
+    Memory::TypedUnorderedPool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolPageReleasePolicy (pool);
+}
+
+BOOST_AUTO_TEST_CASE (DecommitReleasedPages)
+{
+    Memory::TypedUnorderedPool <NonTrivialData> pool {Memory::PageSize {DECOMMIT_PAGE_SIZE}};
+    TestAnyPoolDecommitReleasedPages (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageDepot)
+{
+    Memory::TypedUnorderedPool <NonTrivialData> first {DEFAULT_PAGE_CAPACITY};
+    Memory::TypedUnorderedPool <NonTrivialData> second {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolPageDepot (first, second);
+}
+
+BOOST_AUTO_TEST_CASE (PageProvisioner)
+{
+    Memory::PageProvisioner provisioner {DEFAULT_PAGE_CAPACITY, sizeof (NonTrivialData), 1u, 2u};
+    Memory::TypedUnorderedPool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolPageProvisioner (pool, provisioner);
+}
+
+BOOST_AUTO_TEST_CASE (Emplace)
+{
+    Memory::TypedUnorderedPool <
+        NonTrivialData, Memory::EntryDefaultConstructor, CountingNonTrivialDataDestructor> pool {DEFAULT_PAGE_CAPACITY};
+    NonTrivialData source;
+    source.values_ = {1u, 2u, 3u};
+    source.first_ = 10u;
+
+    // Copy constructor may throw, but Emplace still accepts it.
+    NonTrivialData *copied = pool.Emplace (source);
+    BOOST_REQUIRE (*copied == source);
+
+    // Uninitialized entry is constructed by caller, but still destructed by pool.
+    auto *uninitialized = new (pool.AcquireUninitialized ()) NonTrivialData (source);
+    BOOST_REQUIRE (*uninitialized == source);
+
+    NonTrivialData *moved = pool.Emplace (std::move (source));
+    BOOST_REQUIRE (*moved == *copied);
+
+    NonTrivialData *constructed = pool.Emplace ();
+    BOOST_REQUIRE (*constructed == NonTrivialData ());
+
+    nonTrivialDataDestructorCallCount = 0u;
+    pool.Free (copied);
+    pool.Free (uninitialized);
+    pool.Free (moved);
+    pool.Free (constructed);
+    BOOST_REQUIRE (nonTrivialDataDestructorCallCount == 4u);
+}
+
+BOOST_AUTO_TEST_CASE (EmplaceThrowing)
+{
+    Memory::TypedUnorderedPool <ThrowingData> pool {DEFAULT_PAGE_CAPACITY};
+    TestNonTrivialPoolEmplaceThrowing (pool);
+}
+
+BOOST_AUTO_TEST_CASE (Clean)
+{
+    Memory::TypedUnorderedPool <
+        NonTrivialData, Memory::EntryDefaultConstructor, CountingNonTrivialDataDestructor> pool {DEFAULT_PAGE_CAPACITY};
+    TestNonTrivialPoolClean (
+        pool, nonTrivialDataDestructorCallCount,
+        [] (auto &pool)
+        {
+            pool.Clean ();
+        });
+}
+
+BOOST_AUTO_TEST_CASE (ParallelClean)
+{
+    Memory::TypedUnorderedPool <
+        NonTrivialData, Memory::EntryDefaultConstructor, CountingNonTrivialDataDestructor> pool {DEFAULT_PAGE_CAPACITY};
+    TestNonTrivialPoolClean (
+        pool, nonTrivialDataDestructorCallCount,
+        [] (auto &pool)
+        {
+            pool.Clean (Memory::ThreadParallelExecutor, 1u);
+        });
+}
+
+BOOST_AUTO_TEST_CASE (ParallelCleanWithPageCapacityGrowth)
+{
+    Memory::TypedUnorderedPool <
+        NonTrivialData, Memory::EntryDefaultConstructor, CountingNonTrivialDataDestructor> pool {DEFAULT_PAGE_CAPACITY};
+    pool.SetMaxPageCapacity (DEFAULT_PAGE_CAPACITY * 8u);
+    std::vector <NonTrivialData *> values;
+
+    // Pages with capacities 1, 2 and 4 of default page capacity are created.
+    for (uint32_t itemIndex = 0u; itemIndex < DEFAULT_PAGE_CAPACITY * 7u; ++itemIndex)
+    {
+        values.push_back (pool.Acquire ());
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 3u);
+    uint32_t freedCount = 0u;
+
+    for (uint32_t itemIndex = 0u; itemIndex < values.size (); itemIndex += 3u)
+    {
+        pool.Free (values[itemIndex]);
+        ++freedCount;
+    }
+
+    nonTrivialDataDestructorCallCount = 0u;
+    pool.Clean (Memory::ThreadParallelExecutor, 1u);
+    BOOST_REQUIRE (nonTrivialDataDestructorCallCount == values.size () - freedCount);
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+}
+
+BOOST_AUTO_TEST_CASE (ParallelCleanWithCustomExecutor)
+{
+    Memory::TypedUnorderedPool <
+        NonTrivialData, Memory::EntryDefaultConstructor, CountingNonTrivialDataDestructor> pool {DEFAULT_PAGE_CAPACITY};
+    uint32_t executedTaskCount = 0u;
+    TestNonTrivialPoolClean (
+        pool, nonTrivialDataDestructorCallCount,
+        [&executedTaskCount] (auto &pool)
+        {
+            pool.Clean (
+                [&executedTaskCount] (Memory::SizeType taskCount, const Memory::ParallelTask &task)
+                {
+                    // Execute tasks in reverse order to check that tasks are independent.
+                    for (Memory::SizeType taskIndex = taskCount; taskIndex > 0u; --taskIndex)
+                    {
+                        task (taskIndex - 1u);
+                        ++executedTaskCount;
+                    }
+                },
+                2u);
+        });
+
+    // Test case has three pages, therefore two tasks are expected.
+    BOOST_REQUIRE (executedTaskCount == 2u);
+}
+
+static_assert (!Memory::IsEntryDestructionTrivial <NonTrivialData, Memory::EntryDefaultDestructor> ());
+static_assert (Memory::IsEntryDestructionTrivial <TriviallyDestructibleData, Memory::EntryDefaultDestructor> ());
+static_assert (!Memory::IsEntryDestructionTrivial <NonTrivialData, CustomNonTrivialDataDestructor> ());
+
+BOOST_AUTO_TEST_CASE (TriviallyDestructibleAcquireAndClean)
+{
+    Memory::TypedUnorderedPool <TriviallyDestructibleData> pool {DEFAULT_PAGE_CAPACITY};
+    std::vector <TriviallyDestructibleData *> values;
+
+    for (uint32_t index = 0u; index < DEFAULT_PAGE_CAPACITY * 2u; ++index)
+    {
+        values.push_back (pool.Acquire ());
+        BOOST_REQUIRE (*values.back () == TriviallyDestructibleData ());
+    }
+
+    pool.Free (values.front ());
+    pool.Clean ();
+    BOOST_REQUIRE (pool.GetPageCount () == 0u);
+    TestAnyPoolAcquirePageCount (pool);
+}
+
+BOOST_AUTO_TEST_CASE (TriviallyDestructibleShrink)
+{
+    Memory::TypedUnorderedPool <TriviallyDestructibleData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolShrink (pool);
+}
+
+BOOST_AUTO_TEST_CASE (Compact)
+{
+    Memory::TypedUnorderedPool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolCompact (
+        pool,
+        [] (Memory::TypedUnorderedPool <NonTrivialData> &pool, Memory::SizeType budget)
+        {
+            return pool.Compact (budget);
+        });
+}
+
+BOOST_AUTO_TEST_CASE (CompactWithRelocator)
+{
+    Memory::TypedUnorderedPool <NonTrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    std::vector <NonTrivialData *> values;
+
+    for (uint32_t index = 0u; index < DEFAULT_PAGE_CAPACITY * 2u; ++index)
+    {
+        NonTrivialData *data = pool.Acquire ();
+        data->first_ = index;
+        data->values_.push_back (index);
+        values.push_back (data);
+    }
+
+    for (uint32_t index = 0u; index < DEFAULT_PAGE_CAPACITY; ++index)
+    {
+        if (index % 2u != 0u)
+        {
+            pool.Free (values[index]);
+            pool.Free (values[DEFAULT_PAGE_CAPACITY + index]);
+            values[index] = nullptr;
+            values[DEFAULT_PAGE_CAPACITY + index] = nullptr;
+        }
+    }
+
+    // Relocator updates references to moved values, like user code is expected to do.
+    while (!pool.Compact (
+        DEFAULT_PAGE_CAPACITY,
+        [&values] (NonTrivialData *source, NonTrivialData *target)
+        {
+            *std::find (values.begin (), values.end (), source) = target;
+            Memory::EntryDefaultRelocator (source, target);
+        }))
+    {
+    }
+
+    BOOST_REQUIRE (pool.GetPageCount () == 1u);
+    for (uint32_t index = 0u; index < values.size (); ++index)
+    {
+        if (values[index])
+        {
+            BOOST_REQUIRE (values[index]->first_ == index);
+            BOOST_REQUIRE (values[index]->values_.size () == 1u && values[index]->values_[0u] == index);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
\ No newline at end of file
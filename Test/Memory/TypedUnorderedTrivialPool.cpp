@@ -5,6 +5,10 @@
 BOOST_AUTO_TEST_SUITE (TypedUnorderedTrivialPool)
 
 #define DEFAULT_PAGE_CAPACITY 32u
+#define DEFAULT_PAGE_SIZE 4096u
+
+// Pages must span several operating system pages, otherwise there is nothing to decommit.
+#define DECOMMIT_PAGE_SIZE 65536u
 
 BOOST_AUTO_TEST_CASE (AcquireAndFree)
 {
@@ -22,16 +26,102 @@ BOOST_AUTO_TEST_CASE (AcquireAndFree)
         });
 }
 
+BOOST_AUTO_TEST_CASE (Emplace)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TrivialData *data = pool.Emplace (uint8_t {12u}, uint8_t {255u}, uint8_t {99u}, uint8_t {125u}, uint64_t {78912u});
+
+    BOOST_REQUIRE (data->a_ == 12u);
+    BOOST_REQUIRE (data->b_ == 255u);
+    BOOST_REQUIRE (data->c_ == 99u);
+    BOOST_REQUIRE (data->d_ == 125u);
+    BOOST_REQUIRE (data->otherValue_ == 78912u);
+    pool.Free (data);
+}
+
 BOOST_AUTO_TEST_CASE (AcquirePageCount)
 {
     Memory::TypedUnorderedTrivialPool <TrivialData> pool {DEFAULT_PAGE_CAPACITY};
     TestAnyPoolAcquirePageCount (pool);
 }
 
+BOOST_AUTO_TEST_CASE (AcquirePageCountWithPageSize)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {Memory::PageSize {DEFAULT_PAGE_SIZE}};
+    TestAnyPoolPageSize (pool, DEFAULT_PAGE_SIZE, sizeof (TrivialData));
+}
+
 BOOST_AUTO_TEST_CASE (Shrink)
 {
     Memory::TypedUnorderedTrivialPool <TrivialData> pool {DEFAULT_PAGE_CAPACITY};
     TestAnyPoolShrink(pool);
 }
 
+BOOST_AUTO_TEST_CASE (ShrinkStep)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolShrinkStep (pool);
+}
+
+BOOST_AUTO_TEST_CASE (ShrinkStepBudget)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolShrinkStepBudget (pool);
+}
+
+BOOST_AUTO_TEST_CASE (Reserve)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolReserve (pool);
+}
+
+BOOST_AUTO_TEST_CASE (ReserveDuringShrinkStep)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {4u};
+    TestAnyPoolReserveDuringShrinkStep (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageCapacityGrowth)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolPageCapacityGrowth (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageReleasePolicy)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolPageReleasePolicy (pool);
+}
+
+BOOST_AUTO_TEST_CASE (DecommitReleasedPages)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {Memory::PageSize {DECOMMIT_PAGE_SIZE}};
+    TestAnyPoolDecommitReleasedPages (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageDepot)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> first {DEFAULT_PAGE_CAPACITY};
+    Memory::TypedUnorderedTrivialPool <TrivialData> second {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolPageDepot (first, second);
+}
+
+BOOST_AUTO_TEST_CASE (PageProvisioner)
+{
+    Memory::PageProvisioner provisioner {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData), 1u, 2u};
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolPageProvisioner (pool, provisioner);
+}
+
+BOOST_AUTO_TEST_CASE (Compact)
+{
+    Memory::TypedUnorderedTrivialPool <TrivialData> pool {DEFAULT_PAGE_CAPACITY};
+    TestAnyPoolCompact (
+        pool,
+        [] (Memory::TypedUnorderedTrivialPool <TrivialData> &pool, Memory::SizeType budget)
+        {
+            return pool.Compact (budget);
+        });
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
\ No newline at end of file
@@ -5,6 +5,10 @@
 BOOST_AUTO_TEST_SUITE (UnorderedPool)
 
 #define DEFAULT_PAGE_CAPACITY 32u
+#define DEFAULT_PAGE_SIZE 4096u
+
+// Pages must span several operating system pages, otherwise there is nothing to decommit.
+#define DECOMMIT_PAGE_SIZE 65536u
 
 void NonTrivialDataConstructor (void *chunk) noexcept
 {
@@ -16,6 +20,12 @@ void NonTrivialDataDestructor (void *chunk) noexcept
     static_cast <NonTrivialData *> (chunk)->~NonTrivialData ();
 }
 
+void NonTrivialDataRelocator (void *source, void *target) noexcept
+{
+    new (target) NonTrivialData (std::move (*static_cast <NonTrivialData *> (source)));
+    NonTrivialDataDestructor (source);
+}
+
 static bool nonTrivialDataDestructorCalled = false;
 
 void CustomNonTrivialDataDestructor (void *chunk) noexcept
@@ -24,6 +34,14 @@ void CustomNonTrivialDataDestructor (void *chunk) noexcept
     NonTrivialDataDestructor (chunk);
 }
 
+static std::atomic <uint32_t> nonTrivialDataDestructorCallCount {0u};
+
+void CountingNonTrivialDataDestructor (void *chunk) noexcept
+{
+    ++nonTrivialDataDestructorCallCount;
+    NonTrivialDataDestructor (chunk);
+}
+
 static Memory::UnorderedPool ConstructDefaultPool ()
 {
     return Memory::UnorderedPool (
@@ -47,10 +65,132 @@ BOOST_AUTO_TEST_CASE (AcquirePageCount)
     TestAnyPoolAcquirePageCount (pool);
 }
 
+BOOST_AUTO_TEST_CASE (AcquirePageCountWithPageSize)
+{
+    Memory::UnorderedPool pool {Memory::PageSize {DEFAULT_PAGE_SIZE}, sizeof (NonTrivialData),
+                                NonTrivialDataConstructor, NonTrivialDataDestructor};
+    TestAnyPoolPageSize (pool, DEFAULT_PAGE_SIZE, sizeof (NonTrivialData));
+}
+
 BOOST_AUTO_TEST_CASE (Shrink)
 {
     Memory::UnorderedPool pool = ConstructDefaultPool ();
     TestAnyPoolShrink (pool);
 }
 
+BOOST_AUTO_TEST_CASE (ShrinkStep)
+{
+    Memory::UnorderedPool pool = ConstructDefaultPool ();
+    TestAnyPoolShrinkStep (pool);
+}
+
+BOOST_AUTO_TEST_CASE (Reserve)
+{
+    Memory::UnorderedPool pool = ConstructDefaultPool ();
+    TestAnyPoolReserve (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageCapacityGrowth)
+{
+    Memory::UnorderedPool pool = ConstructDefaultPool ();
+    TestAnyPoolPageCapacityGrowth (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageReleasePolicy)
+{
+    Memory::UnorderedPool pool = ConstructDefaultPool ();
+    TestAnyPoolPageReleasePolicy (pool);
+}
+
+BOOST_AUTO_TEST_CASE (DecommitReleasedPages)
+{
+    Memory::UnorderedPool pool {Memory::PageSize {DECOMMIT_PAGE_SIZE}, sizeof (NonTrivialData),
+                                NonTrivialDataConstructor, NonTrivialDataDestructor};
+    TestAnyPoolDecommitReleasedPages (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageDepot)
+{
+    Memory::UnorderedPool first {DEFAULT_PAGE_CAPACITY, sizeof (NonTrivialData),
+                                 NonTrivialDataConstructor, NonTrivialDataDestructor};
+    Memory::UnorderedPool second {DEFAULT_PAGE_CAPACITY, sizeof (NonTrivialData),
+                                  NonTrivialDataConstructor, NonTrivialDataDestructor};
+    TestAnyPoolPageDepot (first, second);
+}
+
+BOOST_AUTO_TEST_CASE (PageProvisioner)
+{
+    Memory::PageProvisioner provisioner {DEFAULT_PAGE_CAPACITY, sizeof (NonTrivialData), 1u, 2u};
+    Memory::UnorderedPool pool {DEFAULT_PAGE_CAPACITY, sizeof (NonTrivialData),
+                                NonTrivialDataConstructor, NonTrivialDataDestructor};
+    TestAnyPoolPageProvisioner (pool, provisioner);
+}
+
+BOOST_AUTO_TEST_CASE (Clean)
+{
+    Memory::UnorderedPool pool {
+        DEFAULT_PAGE_CAPACITY, sizeof (NonTrivialData),
+        NonTrivialDataConstructor, CountingNonTrivialDataDestructor};
+
+    TestNonTrivialPoolClean (
+        pool, nonTrivialDataDestructorCallCount,
+        [] (auto &pool)
+        {
+            pool.Clean ();
+        });
+}
+
+BOOST_AUTO_TEST_CASE (ParallelClean)
+{
+    Memory::UnorderedPool pool {
+        DEFAULT_PAGE_CAPACITY, sizeof (NonTrivialData),
+        NonTrivialDataConstructor, CountingNonTrivialDataDestructor};
+
+    TestNonTrivialPoolClean (
+        pool, nonTrivialDataDestructorCallCount,
+        [] (auto &pool)
+        {
+            pool.Clean (Memory::ThreadParallelExecutor, 1u);
+        });
+}
+
+BOOST_AUTO_TEST_CASE (ParallelCleanWithCustomExecutor)
+{
+    Memory::UnorderedPool pool {
+        DEFAULT_PAGE_CAPACITY, sizeof (NonTrivialData),
+        NonTrivialDataConstructor, CountingNonTrivialDataDestructor};
+
+    uint32_t executedTaskCount = 0u;
+    TestNonTrivialPoolClean (
+        pool, nonTrivialDataDestructorCallCount,
+        [&executedTaskCount] (auto &pool)
+        {
+            pool.Clean (
+                [&executedTaskCount] (Memory::SizeType taskCount, const Memory::ParallelTask &task)
+                {
+                    // Execute tasks in reverse order to check that tasks are independent.
+                    for (Memory::SizeType taskIndex = taskCount; taskIndex > 0u; --taskIndex)
+                    {
+                        task (taskIndex - 1u);
+                        ++executedTaskCount;
+                    }
+                },
+                2u);
+        });
+
+    // Test case has three pages, therefore two tasks are expected.
+    BOOST_REQUIRE (executedTaskCount == 2u);
+}
+
+BOOST_AUTO_TEST_CASE (Compact)
+{
+    Memory::UnorderedPool pool = ConstructDefaultPool ();
+    TestAnyPoolCompact (
+        pool,
+        [] (Memory::UnorderedPool &pool, Memory::SizeType budget)
+        {
+            return pool.Compact (budget, NonTrivialDataRelocator);
+        });
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
\ No newline at end of file
@@ -5,6 +5,10 @@
 BOOST_AUTO_TEST_SUITE (UnorderedTrivialPool)
 
 #define DEFAULT_PAGE_CAPACITY 32u
+#define DEFAULT_PAGE_SIZE 4096u
+
+// Pages must span several operating system pages, otherwise there is nothing to decommit.
+#define DECOMMIT_PAGE_SIZE 65536u
 
 BOOST_AUTO_TEST_CASE (AcquireAndFree)
 {
@@ -28,10 +32,83 @@ BOOST_AUTO_TEST_CASE (AcquirePageCount)
     TestAnyPoolAcquirePageCount (pool);
 }
 
+BOOST_AUTO_TEST_CASE (AcquirePageCountWithPageSize)
+{
+    Memory::UnorderedTrivialPool pool {Memory::PageSize {DEFAULT_PAGE_SIZE}, sizeof (TrivialData)};
+    TestAnyPoolPageSize (pool, DEFAULT_PAGE_SIZE, sizeof (TrivialData));
+}
+
 BOOST_AUTO_TEST_CASE (Shrink)
 {
     Memory::UnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
     TestAnyPoolShrink (pool);
 }
 
+BOOST_AUTO_TEST_CASE (ShrinkStep)
+{
+    Memory::UnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
+    TestAnyPoolShrinkStep (pool);
+}
+
+BOOST_AUTO_TEST_CASE (ShrinkStepBudget)
+{
+    Memory::UnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
+    TestAnyPoolShrinkStepBudget (pool);
+}
+
+BOOST_AUTO_TEST_CASE (Reserve)
+{
+    Memory::UnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
+    TestAnyPoolReserve (pool);
+}
+
+BOOST_AUTO_TEST_CASE (ReserveDuringShrinkStep)
+{
+    Memory::UnorderedTrivialPool pool {4u, sizeof (TrivialData)};
+    TestAnyPoolReserveDuringShrinkStep (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageCapacityGrowth)
+{
+    Memory::UnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
+    TestAnyPoolPageCapacityGrowth (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageReleasePolicy)
+{
+    Memory::UnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
+    TestAnyPoolPageReleasePolicy (pool);
+}
+
+BOOST_AUTO_TEST_CASE (DecommitReleasedPages)
+{
+    Memory::UnorderedTrivialPool pool {Memory::PageSize {DECOMMIT_PAGE_SIZE}, sizeof (TrivialData)};
+    TestAnyPoolDecommitReleasedPages (pool);
+}
+
+BOOST_AUTO_TEST_CASE (PageDepot)
+{
+    Memory::UnorderedTrivialPool first {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
+    Memory::UnorderedTrivialPool second {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
+    TestAnyPoolPageDepot (first, second);
+}
+
+BOOST_AUTO_TEST_CASE (PageProvisioner)
+{
+    Memory::PageProvisioner provisioner {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData), 1u, 2u};
+    Memory::UnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
+    TestAnyPoolPageProvisioner (pool, provisioner);
+}
+
+BOOST_AUTO_TEST_CASE (Compact)
+{
+    Memory::UnorderedTrivialPool pool {DEFAULT_PAGE_CAPACITY, sizeof (TrivialData)};
+    TestAnyPoolCompact (
+        pool,
+        [] (Memory::UnorderedTrivialPool &pool, Memory::SizeType budget)
+        {
+            return pool.Compact (budget);
+        });
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
\ No newline at end of file